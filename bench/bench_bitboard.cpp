@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <functional>
+#include "AIPlayer.hpp"
+
+/*  Headless microbenchmarks of the BitBoard primitives, the pattern detectors and the evaluation
+    (`make bench_bitboard && ./bench_bitboard`). Every benchmark runs over the same fixed corpus of
+    early, mid and late game positions, and reports the best time of several trials in ns per
+    position, so two builds can be compared on the same machine.
+*/
+
+# define POSITIONS 16       /* number of positions per game phase */
+# define TRIALS 7           /* number of timed trials per benchmark, the fastest one is reported */
+# define MIN_TRIAL_NS 2e7   /* minimum duration of a trial (the number of passes over the corpus is doubled until it is reached) */
+# define SEED 4242          /* the seed of the corpus, keep it fixed so the results stay comparable */
+
+typedef struct  s_phase {
+    const char          *name;
+    int                 stones;     /* number of moves played from the empty board */
+    std::vector<t_node> nodes;
+}               t_phase;
+
+typedef std::function<uint64_t(t_node const &)>    t_bench_func;
+
+static volatile uint64_t    g_sink = 0; /* keeps the benchmarked results alive */
+
+/* exposes the protected AIPlayer methods to the benchmarks */
+class BenchPlayer : public AIPlayer {
+
+public:
+    BenchPlayer(void) : AIPlayer(1, 1) {};
+    ~BenchPlayer(void) {};
+
+    t_ret const         operator()(t_node) { return ((t_ret){ 0, -1 }); };
+    t_node              child(t_node const &node, int i) { return (this->create_child(node, i)); };
+    std::vector<t_move> moves(t_node const &node) { return (this->move_generation(node, 1)); };
+};
+
+static t_node   empty_node(void) {
+    t_node  node;
+
+    node.player_patterns.fill(0);
+    node.opponent_patterns.fill(0);
+    node.player_threes.fill(0);
+    node.opponent_threes.fill(0);
+    node.hash = ZobristTable::hash(node.player, node.opponent, 0, 0);
+    node.cid = 1;
+    node.player_pairs_captured = 0;
+    node.opponent_pairs_captured = 0;
+    node.move = CELLS / 2;
+    return (node);
+}
+
+/*  play a game of `stones` random moves next to the stones already placed (the first one in the
+    center), a move completing a five or forbidden for the side to move is never chosen
+*/
+static t_node   random_position(BenchPlayer &ai, std::mt19937 &rng, int stones) {
+    t_node      node = empty_node();
+    t_node      child;
+    BitBoard    candidates;
+    int         count;
+
+    node = ai.child(node, CELLS / 2);
+    for (int m = 1; m < stones; ++m) {
+        candidates = BitBoard(node.player | node.opponent).dilated() & ~node.player & ~node.opponent;
+        candidates &= ~(node.cid == 1 ? node.player_forbidden : node.opponent_forbidden);
+        for (count = candidates.set_count(); count > 0; --count) {
+            BitBoard::iterator  it = candidates.begin();
+            for (int k = rng() % count; k > 0; --k)
+                ++it;
+            child = ai.child(node, *it);
+            if (!detect_five_aligned(child.player) && !detect_five_aligned(child.opponent))
+                break;
+            candidates.remove(*it);
+        }
+        if (count == 0)
+            break;
+        node = child;
+    }
+    return (node);
+}
+
+/* return the best time of TRIALS trials of `func` over the positions of `phase`, in ns per position */
+static double   run(t_bench_func const &func, t_phase const &phase) {
+    double      best = 0;
+    double      elapsed = 0;
+    uint64_t    sink = 0;
+    int         passes = 1;
+
+    /* calibration : double the number of passes over the corpus until a trial lasts MIN_TRIAL_NS */
+    while (elapsed < MIN_TRIAL_NS) {
+        passes *= 2;
+        auto    start = std::chrono::steady_clock::now();
+        for (int p = 0; p < passes; ++p)
+            for (t_node const &node : phase.nodes)
+                sink += func(node);
+        elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    for (int t = 0; t < TRIALS; ++t) {
+        auto    start = std::chrono::steady_clock::now();
+        for (int p = 0; p < passes; ++p)
+            for (t_node const &node : phase.nodes)
+                sink += func(node);
+        elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (t == 0 || elapsed < best)
+            best = elapsed;
+    }
+    g_sink += sink;
+    return (best / (passes * phase.nodes.size()));
+}
+
+static void     bench(std::string const &name, t_bench_func const &func, std::vector<t_phase> const &phases) {
+    std::printf("%-36s", name.c_str());
+    for (t_phase const &phase : phases)
+        std::printf(" %10.1f", run(func, phase));
+    std::printf("\n");
+}
+
+int             main(void) {
+    BenchPlayer             ai;
+    std::mt19937            rng(SEED);
+    std::vector<t_phase>    phases = {
+        { "early", 10, {} },
+        { "mid", 40, {} },
+        { "late", 90, {} }
+    };
+    char                    name[64];
+
+    for (t_phase &phase : phases)
+        for (int n = 0; n < POSITIONS; ++n)
+            phase.nodes.push_back(random_position(ai, rng, phase.stones));
+
+    std::printf("board %dx%d, %d positions per phase, ns per position (best of %d trials)\n\n", BOARD_SIZE, BOARD_SIZE, POSITIONS, TRIALS);
+    std::printf("%-36s", "benchmark");
+    for (t_phase const &phase : phases)
+        std::printf(" %10s", phase.name);
+    std::printf("\n");
+
+    /* primitives */
+    bench("shifted (8 directions)", [](t_node const &node) {
+        uint64_t    res = 0;
+        for (int d = 0; d < DIRS; ++d)
+            res += node.player.shifted(d).values[NICB / 2];
+        return (res);
+    }, phases);
+    bench("dilated", [](t_node const &node) { return (node.player.dilated().values[NICB / 2]); }, phases);
+    /* detectors */
+    bench("forbidden_detector", [](t_node const &node) { return (forbidden_detector(node.player, node.opponent).set_count()); }, phases);
+    bench("forbidden_detector (LineBoard)", [](t_node const &node) {
+        std::array<uint32_t, LINES> threes;
+        return (forbidden_detector(node.player_lines, node.opponent_lines, threes).set_count());
+    }, phases);
+    for (t_pattern const &pattern : BitBoard::patterns) {
+        std::snprintf(name, sizeof(name), "future_pattern_detector 0x%02X", pattern.repr);
+        bench(name, [&pattern](t_node const &node) { return (future_pattern_detector(node.player, node.opponent, pattern).set_count()); }, phases);
+    }
+    bench("win_by_capture_detector", [](t_node const &node) { return (win_by_capture_detector(node.player, node.opponent, 3).set_count()); }, phases);
+    bench("highlight_captured_stones", [](t_node const &node) {
+        return (highlight_captured_stones(node.cid == 1 ? node.opponent : node.player, node.cid == 1 ? node.player : node.opponent, node.move).set_count());
+    }, phases);
+    /* evaluation */
+    bench("score_function", [&ai](t_node const &node) { return ((uint64_t)ai.score_function(node, 1)); }, phases);
+    bench("move_generation", [&ai](t_node const &node) { return (ai.moves(node).size()); }, phases);
+    return (0);
+}
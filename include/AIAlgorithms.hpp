@@ -4,7 +4,34 @@
 # include <math.h>
 # include <random>
 # include <iostream>
+# include <atomic>
+# include <thread>
 # include "AIPlayer.hpp"
+# include "SplitPool.hpp"
+# include "MCTSArena.hpp"
+# include "Xoshiro.hpp"
+
+# define SPLIT_DEPTH 2  /* minimum remaining depth of a node whose moves are split between the threads (split search) */
+# define VIRTUAL_LOSS 1 /* number of visits (without win) added to the nodes selected by a thread until its rollout is backpropagated (MCTS) */
+# define ROLLOUT_DEPTH 40   /* number of plies of a rollout before the position is scored by the heuristic (MCTS) */
+# define PUCT_C 1.5         /* weight of the prior of a child against its mean value (PUCT) */
+# define PUCT_TEMPERATURE 100   /* evaluation gap dividing the prior of a move by e (PUCT) */
+# define WIDENING_BASE 2    /* number of childs a node never visited selects from (PUCT) */
+# define WIDENING_EXPONENT 0.5  /* a node visited n times selects from its WIDENING_BASE + n^WIDENING_EXPONENT best childs (PUCT) */
+
+namespace smp {
+    enum smp {
+        lazy,   /* Lazy SMP : the threads search the same root and share the transposition table */
+        split   /* Young Brothers Wait : the moves of a node are split between the threads once its first move is searched */
+    };
+};
+
+namespace selection {
+    enum selection {
+        uct,    /* UCB1 : the untried moves of a node are expanded one by one in a random order */
+        puct    /* the childs of a node are created at once with a prior from evaluation_function, and widened by rank with the visits */
+    };
+};
 
 class MinMax: public AIPlayer {
 
@@ -39,7 +66,7 @@ private:
 class MTDf: public AIPlayer {
 
 public:
-    MTDf(int depth, uint8_t pid, uint8_t verbose = verbose::quiet);
+    MTDf(int depth, uint8_t pid, uint8_t verbose = verbose::quiet, size_t tt_mb = TT_SIZE_MB);
     MTDf(MTDf const &src);
     ~MTDf(void);
     MTDf    &operator=(MTDf const &);
@@ -58,12 +85,14 @@ private:
 class AlphaBetaCustom: public AIPlayer {
 
 public:
-    AlphaBetaCustom(int depth, uint8_t pid, uint8_t verbose = verbose::quiet, int time_limit = 500);
+    AlphaBetaCustom(int depth, uint8_t pid, uint8_t verbose = verbose::quiet, int time_limit = 500, int threads = 1, int mode = smp::lazy, size_t tt_mb = TT_SIZE_MB);
     AlphaBetaCustom(AlphaBetaCustom const &src);
     ~AlphaBetaCustom(void);
     AlphaBetaCustom	&operator=(AlphaBetaCustom const &rhs);
 
     int         get_search_limit_ms(void) const { return (_search_limit_ms); };
+    int         get_threads(void) const { return (_threads); };
+    int         get_mode(void) const { return (_mode); };
 
     virtual t_ret const operator()(t_node root);
 
@@ -71,14 +100,30 @@ public:
     bool    reached_end;
 
 private:
+    AlphaBetaCustom(AlphaBetaCustom const &main, int helper_id);    // a Lazy SMP helper or a split worker, sharing the table and the stop flag of `main`
+
     int                                     _current_max_depth;
     std::chrono::steady_clock::time_point   _search_start;
     int                                     _search_limit_ms;
     std::vector<t_move>                     _root_moves;
-
+    int                                     _threads;       /* number of threads searching (the main one and threads-1 helpers) */
+    int                                     _mode;          /* smp::lazy or smp::split */
+    int                                     _helper_id;     /* 0 for the main search (the worker id in the split search) */
+    std::atomic<bool>                       _stop;          /* set when the time is up or the main search is over */
+    std::atomic<bool>                       *_shared_stop;  /* the stop flag of the main search */
+    AlphaBetaCustom                         *_main;         /* the main search (itself for the main search) */
+    SplitPool                               *_pool;         /* the pool of the split search, null when the moves are not split */
+    std::vector<AlphaBetaCustom *>          _workers;       /* the search run by each worker of the pool (the main search first) */
+
+    t_ret                                   _iterative_deepening(t_node root, int first_depth);
+    void                                    _helper_search(t_node root, int helper_id);
+    t_ret                                   _split_search(t_node root);
+    t_ret                                   _split(std::vector<t_move> &moves, size_t first, t_ret best, int alpha, int beta, int depth, int skip, bool maximizing);
     t_ret                                   _root_max(t_node node, int alpha, int beta, int depth);
     t_ret                                   _max(t_node node, int alpha, int beta, int depth);
     t_ret                                   _min(t_node node, int alpha, int beta, int depth);
+    bool                                    _probe_cutoff(t_stored const &stored, int &alpha, int &beta);
+    void                                    _store(t_node const &node, t_ret const &best, int alpha, int beta, int depth);
 
     void                                    _debug_append_explored(int score, int i, int depth);
     void                                    _debug_search(t_ret const& ret);
@@ -87,66 +132,47 @@ private:
     int                                     _elapsed_ms(void);
 };
 
-class MCTSNode {
-
-public:
-    MCTSNode(MCTSNode *parent, int move, int wins, int visit, std::vector<t_move> moves);
-    MCTSNode(MCTSNode const &src);
-    ~MCTSNode(void);
-    MCTSNode	&operator=(MCTSNode const &rhs);
-
-    MCTSNode                *get_parent(void) const { return (this->_parent); };
-    int                     get_playerid(void) const { return (this->_playerid); };
-    int                     get_move(void) const { return (this->_move); };
-    int                     get_wins(void) const { return (this->_wins); };
-    int                     get_visit(void) const { return (this->_visit); };
-    std::vector<MCTSNode *> get_childs(void) const { return (this->_childs); };
-    std::vector<t_move>     get_untried_actions(void) const { return (this->_untried_actions); };
-
-    void                    set_wins(int value) { this->_wins = value; return ; };
-    void                    inc_wins(int score) { this->_wins += score; return ; };
-    void                    inc_visit(void) { this->_visit++; return ; };
-
-    void                    add_child(MCTSNode *node);
-    void                    remove_action(int index);
-
-private:
-    MCTSNode                *_parent;           // parent node
-    int                     _playerid;          // player ID
-    int                     _move;              // position played to reach the state contained in node
-    int                     _wins;              // number of wins
-    int                     _visit;             // number of visitation
-    std::vector<MCTSNode *> _childs;            // vector of childs nodes
-    std::vector<t_move>     _untried_actions;   // moves available at that state
-
-};
-
-std::ostream &operator<<(std::ostream &o, const MCTSNode &rhs);
-
+/*  Tree-parallel MCTS : the nodes are stored in an arena shared by the threads, the statistics of a node
+    are atomic, and each untried move is claimed by one thread (clearing its bit) which then pushes the
+    child in the list of the node, so the tree grows without locks. The tree is kept between the searches,
+    a search starting from the subtree of the move played and of the reply of the opponent. With the PUCT
+    selection, the moves of a node are ranked and given a prior by evaluation_function when it is expanded.
+    The final states are proven wins, the proofs are propagated up the tree and the solved subtrees are no
+    longer selected : the search ends as soon as the root is solved.
+*/
 class MCTS: public AIPlayer {
 
 public:
-    MCTS(int depth, uint8_t pid, uint8_t verbose = verbose::quiet, int time_max = 499);
+    MCTS(int depth, uint8_t pid, uint8_t verbose = verbose::quiet, int time_max = 499, int threads = 1, size_t arena_mb = MCTS_ARENA_MB, int policy = selection::uct);
     MCTS(MCTS const &src);
     ~MCTS(void);
     MCTS	&operator=(MCTS const &rhs);
 
     virtual t_ret const operator()(t_node root);
-    void        debugchilds(MCTSNode *node, int level);                 // Display the tree for bebug purpose
+    void        debugchilds(int32_t node, int level);                   // Display the tree for bebug purpose
 
 private:
     t_ret       mcts(t_node root_state);                                // MCTS
-
-    MCTSNode    *select_promising_node(MCTSNode *root, t_node &state);  // Select phase
-    void        expand_node(MCTSNode &root, t_node &state);             // Expand phase
-    MCTSNode    *get_random_node(MCTSNode &node);                       // Roll out or simulation phase
-    int         rollout(t_node state);                                  // Roll out or simulation phase
+    void        playouts(int32_t root, t_node const &root_state);       // run the MCTS iterations of one thread until the time is up
+    int32_t     reuse_tree(t_node const &root_state);                   // keep the subtree of the previous search reaching `root_state`
+
+    int32_t     select_promising_node(int32_t root, t_node &state);     // Select phase
+    int32_t     expand_node(int32_t node, t_node &state, Xoshiro256 &rng);  // Expand phase
+    int32_t     expand_ranked(int32_t node, t_node &state);             // Expand phase (PUCT)
+    int         rollout(t_node state, Xoshiro256 &rng);                 // Roll out or simulation phase
+    int         rollout_move(t_node const &state, Xoshiro256 &rng);     // Roll out or simulation phase
     int         MCTS_check_end(t_node *state);                          // Roll out or simulation phase
-    MCTSNode    *backpropagate(MCTSNode *leaf, int winner);             // Backpropagate phase
-    t_ret       get_best_move(MCTSNode &root_node);                     // Select the best move according to MCTS
+    int32_t     backpropagate(int32_t leaf, int winner);                // Backpropagate phase
+    void        prove(int32_t node, int8_t value);                      // Backpropagate phase (MCTS-Solver)
+    t_ret       get_best_move(int32_t root);                            // Select the best move according to MCTS
 
     std::chrono::steady_clock::time_point _start;
     int         _time_max;
+    int         _threads;   /* number of threads descending the tree */
+    int         _policy;    /* selection::uct or selection::puct */
+    MCTSArena   _tree;      /* the nodes of the tree */
+    int32_t     _root;      /* the root of the previous search, -1 if none */
+    t_node      _root_state;/* the state of the previous root */
     bool        timesup(void);
 
 };
@@ -2,20 +2,32 @@
 # define AIPLAYER_HPP
 
 # include <iostream>
-# include <unordered_map>
 # include <array>
 # include <vector>
 # include <string>
+# include <memory>
 # include "BitBoard.hpp"
-# include "ZobristTable.hpp"
+# include "BitBoardBatch.hpp"
+# include "LineBoard.hpp"
+# include "TranspositionTable.hpp"
 
 # define INF 2147483647
+# define WIN_SCORE 50000000  /* score of a win, multiplied by the remaining depth at which it is found */
 
 class Player;
 
 typedef struct  s_node {
     BitBoard        player;
     BitBoard        opponent;
+    LineBoard       player_lines;   /* the stones of player, line by line (kept in sync with `player`) */
+    LineBoard       opponent_lines; /* the stones of opponent, line by line (kept in sync with `opponent`) */
+    std::array<int, 8>  player_patterns;    /* the number of each of the BitBoard::patterns for player (kept up to date by create_child) */
+    std::array<int, 8>  opponent_patterns;  /* the number of each of the BitBoard::patterns for opponent */
+    std::array<uint32_t, LINES> player_threes;      /* the three_cells of each line for player (kept up to date by create_child) */
+    std::array<uint32_t, LINES> opponent_threes;    /* the three_cells of each line for opponent */
+    BitBoard        player_forbidden;   /* the forbidden cells of player (kept up to date by create_child) */
+    BitBoard        opponent_forbidden; /* the forbidden cells of opponent */
+    uint64_t        hash;           /* the zobrist hash of the stones and pairs captured (kept up to date by create_child) */
     uint8_t         cid;
     uint8_t         player_pairs_captured;
     uint8_t         opponent_pairs_captured;
@@ -59,7 +71,9 @@ public:
     virtual t_ret const operator()(t_node root) = 0;
 
 protected:
-    std::unordered_map<ZobristTable::Key, t_stored, ZobristTable::KeyHash>  _TT;
+    AIPlayer(int depth, uint8_t pid, uint8_t verbose, std::shared_ptr<TranspositionTable> const &tt);   // share the transposition table of another search
+
+    std::shared_ptr<TranspositionTable>                                     _TT;    /* null for the searches not using it */
     int                                                                     _depth;
     uint8_t                                                                 _verbose;
     std::string                                                             _debug_string;
@@ -68,7 +82,7 @@ protected:
     std::vector<t_move> move_generation(t_node const& node, int depth);
 
     t_node              create_child(t_node const &node, int i);
-    int32_t             evaluation_function(t_node const &node, uint8_t depth);
+    void                evaluation_function(std::vector<t_move> &moves, uint8_t depth);
 
     bool                checkEnd(t_node const& node);
 
@@ -81,6 +95,8 @@ protected:
 };
 
 t_node              create_node(Player const& player, Player const& opponent);
+uint64_t            node_key(t_node const& node);
+bool                is_win_score(int score);
 
 BitBoard            get_moves(BitBoard const& player, BitBoard const& opponent, BitBoard const& player_forbidden, int player_pairs_captured, int opponent_pairs_captured);
 bool                sort_ascending(t_move const& a, t_move const& b);
@@ -3,14 +3,23 @@
 
 # include <iostream>
 # include <array>
+# include <utility>
 /* includes for debug purposes */
 # include <bitset>
 # include <string>
 # include <sstream>
 
-# define NICB 6  /* number of int64 composing the bitboard */
-# define DIRS 8  /* number of directions */
-# define BITS 64 /* number of bits */
+# ifndef BOARD_SIZE
+#  define BOARD_SIZE 19 /* number of cells per row and per column (ex : `make BOARD_SIZE=15` for a 15x15 build) */
+# endif
+# if BOARD_SIZE < 15 || BOARD_SIZE > 19
+#  error "BOARD_SIZE must be between 15 and 19"
+# endif
+# define CELLS (BOARD_SIZE * BOARD_SIZE)    /* number of cells on the board */
+# define STRIDE (BOARD_SIZE + 1)            /* number of bits per row (BOARD_SIZE cells followed by 1 guard bit) */
+# define NICB ((STRIDE * BOARD_SIZE + 63) / 64) /* number of int64 composing the bitboard (6 for 19x19, 4 for 15x15) */
+# define DIRS 8    /* number of directions */
+# define BITS 64   /* number of bits */
 
 typedef struct  s_pattern {
     uint8_t     repr;       /* the pattern encoded in big-endian (ex : 01011000 for -O-OO-) */
@@ -20,18 +29,107 @@ typedef struct  s_pattern {
     uint16_t    value_1;    /* the value associated with the pattern if next turn is opponent */
 }               t_pattern;
 
-/*  Implementation of a bitboard representation of a square board of 19*19 using
-    6 long integers (64bits), and bit operations.
+class BitBoard;
+
+/*  Expression templates for the bitwise operators : `a & ~b & ~c` doesn't compute anything,
+    it builds a small tree of nodes (BitBinaryExpr, BitNotExpr) that is evaluated word by word
+    only when assigned to a BitBoard (or when an observer like is_empty is called on it). A whole
+    chain of masks is then computed in a single pass over the 6 int64, without any temporary board.
+    Every node gives access to the int64 at index i of its result through `word(i)`.
 */
-class BitBoard {
+template <typename E>
+class BitExpr {
 
 public:
-    BitBoard(void);
-    BitBoard(std::array<uint64_t, NICB> values);
-    BitBoard(BitBoard const &src);
-    ~BitBoard(void);
-    BitBoard	&operator=(BitBoard const &rhs);
+    constexpr uint64_t  word(const int i) const { return (static_cast<E const &>(*this).word(i)); };
+
+    constexpr bool      check_bit(const uint64_t i) const;                      // check if the bit a position i is set to 1
+    constexpr bool      check_bit(const uint64_t x, const uint64_t y) const;    // check if the bit a position x, y is set to 1
+    constexpr bool      is_empty(void) const;                                   // check if all bits are set to 0
+    constexpr int       set_count(void) const;                                  // return the number of bits set to 1
+    constexpr uint64_t  operator[](const int i) const;                          // will return the i-th bit
+};
+
+/* the boards are held by reference in the nodes, the nodes by value (they only hold references) */
+template <typename E>
+struct  BitOperand { typedef E const type; };
+template <>
+struct  BitOperand<BitBoard> { typedef BitBoard const &type; };
+
+struct  BitOr { static constexpr uint64_t apply(const uint64_t a, const uint64_t b) { return (a | b); } };
+struct  BitAnd { static constexpr uint64_t apply(const uint64_t a, const uint64_t b) { return (a & b); } };
+struct  BitXor { static constexpr uint64_t apply(const uint64_t a, const uint64_t b) { return (a ^ b); } };
+
+template <typename L, typename R, typename Op>
+class BitBinaryExpr : public BitExpr<BitBinaryExpr<L, R, Op> > {
+
+public:
+    constexpr BitBinaryExpr(L const &lhs, R const &rhs) : _lhs(lhs), _rhs(rhs) {};
+
+    constexpr uint64_t  word(const int i) const { return (Op::apply(this->_lhs.word(i), this->_rhs.word(i))); };
+
+private:
+    typename BitOperand<L>::type    _lhs;
+    typename BitOperand<R>::type    _rhs;
+};
+
+template <typename E>
+class BitNotExpr : public BitExpr<BitNotExpr<E> > {
+
+public:
+    constexpr explicit BitNotExpr(E const &expr) : _expr(expr) {};
+
+    constexpr uint64_t  word(const int i) const { return (~this->_expr.word(i)); };
+
+private:
+    typename BitOperand<E>::type    _expr;
+};
+
+/*  Implementation of a bitboard representation of a square board of BOARD_SIZE*BOARD_SIZE
+    using NICB long integers (64bits), and bit operations : 6 for a 19x19 board, 4 for a
+    15x15 board. When compiled with AVX2 support the bitwise operators and shifts work on
+    256-bit registers (two for 19x19, a single one for 15x15, see BitBoard.cpp).
+    Rows are stored with a stride of BOARD_SIZE+1 bits, the guard bit at the end of each row
+    is never set, so a one step shift in any direction can't wrap to the next row.
+    Positions given as a single index are cell indices (BOARD_SIZE * y + x), not bit indices.
+*/
+class BitBoard : public BitExpr<BitBoard> {
+
+public:
+    /*  forward iterator over the set bits of the board, yielding cell indices in ascending
+        order (ex : for (int i : moves) { ... }). It scans the words with `lzcnt` so it only
+        costs one step per set bit instead of a check of all the cells.
+    */
+    class iterator {
+
+    public:
+        iterator(uint64_t const *values, int word) : _values(values), _word(word), _bits(word < NICB ? values[word] : 0) { if (word < NICB) this->_skip_empty(); };
+
+        int         operator*(void) const { return (BitBoard::bit_to_cell((this->_word << 6) + __builtin_clzll(this->_bits))); };
+        iterator    &operator++(void) { this->_bits &= ~(0x8000000000000000 >> __builtin_clzll(this->_bits)); this->_skip_empty(); return (*this); };
+        bool        operator==(iterator const &rhs) const { return (this->_word == rhs._word && this->_bits == rhs._bits); };
+        bool        operator!=(iterator const &rhs) const { return (this->_word != rhs._word || this->_bits != rhs._bits); };
+
+    private:
+        uint64_t const  *_values;
+        int             _word;
+        uint64_t        _bits;  /* the bits of the current word that are left to visit */
+
+        void        _skip_empty(void) { while (!this->_bits && ++this->_word < NICB) this->_bits = this->_values[this->_word]; };
+    };
+
+    constexpr BitBoard(void) : values{} {};
+    constexpr BitBoard(std::array<uint64_t, NICB> values) : values(values) {};
+    template <typename E>
+    constexpr BitBoard(BitExpr<E> const &expr) : BitBoard(expr, std::make_index_sequence<NICB>()) {};
+    BitBoard(BitBoard const &src) = default;
+    ~BitBoard(void) = default;
+    BitBoard	&operator=(BitBoard const &rhs) = default;
     BitBoard	&operator=(uint64_t const &val);
+    template <typename E>
+    BitBoard	&operator=(BitExpr<E> const &expr);
+
+    constexpr uint64_t  word(const int i) const { return (this->values[i]); }  // access the int64 at index i
 
     uint64_t    row(uint8_t i) const;                                       // access row at index
 
@@ -40,11 +138,10 @@ public:
     void        remove(const uint64_t i);                                   // set a bit to 0 on the bitboard at position i
     void        write(const uint64_t x, const uint64_t y);                  // set a bit to 1 on the bitboard at position x, y
     void        remove(const uint64_t x, const uint64_t y);                 // set a bit to 0 on the bitboard at position x, y
-    int         set_count(void) const;                                      // return the number of bits set to 1 in bitboard
-    bool        check_bit(const uint64_t i) const;                          // check if the bit a position i is set to 1
-    bool        check_bit(const uint64_t x, const uint64_t y) const;        // check if the bit a position x, y is set to 1
     bool        is_empty(void) const;                                       // check if all bits in the bitboard are set to 0
-    void        broadcast_row(uint64_t line);                               // copy the given row (first 19 bits) to all other rows
+    iterator    begin(void) const { return (iterator(this->values.data(), 0)); };       // iterator on the first set bit
+    iterator    end(void) const { return (iterator(this->values.data(), NICB)); };      // iterator past the last set bit
+    void        broadcast_row(uint64_t line);                               // copy the given row (first BOARD_SIZE bits) to all other rows
     BitBoard    neighbours(void) const;                                     // returns the neighbouring cells
 
     int         leftmost_bit(void) const;                                   // return the positiont of the leftmost set bit
@@ -57,24 +154,23 @@ public:
 
     BitBoard    rotated_45(void);                                           // return the rotated bitboard (not used but here for reference)
 
-    /* arithmetic (bitwise) operator overload */
-    BitBoard    operator|(BitBoard const &rhs) const; // bitwise union
-    BitBoard    operator&(BitBoard const &rhs) const; // bitwise intersection
-    BitBoard    operator^(BitBoard const &rhs) const; // bitwise exclusive or
-    BitBoard    operator~(void) const;                // bitwise complement
+    static uint16_t cell_to_bit(const uint16_t i) { return (i + i / BOARD_SIZE); }    // convert a cell index (BOARD_SIZE * y + x) to a bit index
+    static uint16_t bit_to_cell(const uint16_t b) { return (b - b / STRIDE); }// convert a bit index (STRIDE * y + x) to a cell index
+
+    /* arithmetic (bitwise) operator overload, |, &, ^ and ~ are the BitExpr non-member operators */
     BitBoard    operator>>(const int32_t shift) const;// bitwise right shift
     BitBoard    operator<<(const int32_t shift) const;// bitwise left shift
 
     /* assignment operator overload */
-    BitBoard    &operator|=(BitBoard const &rhs);
-    BitBoard    &operator&=(BitBoard const &rhs);
-    BitBoard    &operator^=(BitBoard const &rhs);
+    template <typename E>
+    BitBoard    &operator|=(BitExpr<E> const &rhs);
+    template <typename E>
+    BitBoard    &operator&=(BitExpr<E> const &rhs);
+    template <typename E>
+    BitBoard    &operator^=(BitExpr<E> const &rhs);
     BitBoard    &operator<<=(const int32_t shift);
     BitBoard    &operator>>=(const int32_t shift);
 
-    /* member access operator overload */
-    uint64_t    operator[](const int i) const; // will return the i-th bit
-
     /* comparison operator overload */
     bool        operator==(BitBoard const &rhs) const;
     bool        operator!=(BitBoard const &rhs) const;
@@ -91,10 +187,104 @@ public:
     static const BitBoard                   border_top;
     static const BitBoard                   border_bottom;
 
+private:
+    /* evaluation of an expression, each int64 is computed in one go from the whole expression */
+    template <typename E, size_t... I>
+    constexpr BitBoard(BitExpr<E> const &expr, std::index_sequence<I...>) : values{{ expr.word(I)... }} {};
+
 };
 
+/*
+** BitExpr observers
+*/
+template <typename E>
+constexpr bool      BitExpr<E>::check_bit(const uint64_t i) const {
+    return (this->word(BitBoard::cell_to_bit(i) >> 6) & (0x8000000000000000 >> (BitBoard::cell_to_bit(i) & 0x3F)));
+}
+
+template <typename E>
+constexpr bool      BitExpr<E>::check_bit(const uint64_t x, const uint64_t y) const {
+    return (this->word((STRIDE * y + x) >> 6) & (0x8000000000000000 >> ((STRIDE * y + x) & 0x3F)));
+}
+
+template <typename E>
+constexpr bool      BitExpr<E>::is_empty(void) const {
+    for (int i = 0; i < NICB; ++i)
+        if (this->word(i))
+            return (false);
+    return (true);
+}
+
+template <typename E>
+constexpr int       BitExpr<E>::set_count(void) const {
+    int         res = 0;
+    for (int i = 0; i < NICB; ++i)
+        res += __builtin_popcountll(this->word(i));
+    return (res);
+}
+
+template <typename E>
+constexpr uint64_t  BitExpr<E>::operator[](const int i) const {
+    return (this->word(i >> 6) & (0x8000000000000000 >> (i & 0x3F)));
+}
+
+/*
+** Bitwise operators (building the expressions)
+*/
+template <typename L, typename R>
+constexpr BitBinaryExpr<L, R, BitOr>    operator|(BitExpr<L> const &lhs, BitExpr<R> const &rhs) {
+    return (BitBinaryExpr<L, R, BitOr>(static_cast<L const &>(lhs), static_cast<R const &>(rhs)));
+}
+
+template <typename L, typename R>
+constexpr BitBinaryExpr<L, R, BitAnd>   operator&(BitExpr<L> const &lhs, BitExpr<R> const &rhs) {
+    return (BitBinaryExpr<L, R, BitAnd>(static_cast<L const &>(lhs), static_cast<R const &>(rhs)));
+}
+
+template <typename L, typename R>
+constexpr BitBinaryExpr<L, R, BitXor>   operator^(BitExpr<L> const &lhs, BitExpr<R> const &rhs) {
+    return (BitBinaryExpr<L, R, BitXor>(static_cast<L const &>(lhs), static_cast<R const &>(rhs)));
+}
+
+template <typename E>
+constexpr BitNotExpr<E>                 operator~(BitExpr<E> const &expr) {
+    return (BitNotExpr<E>(static_cast<E const &>(expr)));
+}
+
+/*
+** Assignation of expressions (evaluated in a new board first, so the operands can alias *this)
+*/
+template <typename E>
+BitBoard    &BitBoard::operator=(BitExpr<E> const &expr) {
+    return (*this = BitBoard(expr));
+}
+
+template <typename E>
+BitBoard    &BitBoard::operator|=(BitExpr<E> const &rhs) {
+    return (*this = BitBoard(*this | rhs));
+}
+
+template <typename E>
+BitBoard    &BitBoard::operator&=(BitExpr<E> const &rhs) {
+    return (*this = BitBoard(*this & rhs));
+}
+
+template <typename E>
+BitBoard    &BitBoard::operator^=(BitExpr<E> const &rhs) {
+    return (*this = BitBoard(*this ^ rhs));
+}
+
 std::ostream	&operator<<(std::ostream &os, BitBoard const &bitboard);
 
+/* the pattern boards of both players computed by `fused_pattern_detector`, index 0 for p1 and 1 for p2 */
+typedef struct  s_pattern_boards {
+    BitBoard    three_four[2];  /* same as three_four_detector */
+    BitBoard    four_four[2];   /* same as four_four_detector */
+    BitBoard    forbidden[2];   /* same as forbidden_detector (double-threes) */
+    BitBoard    captures[2];    /* same as pair_capture_detector (the positions leading to a capture of the other player stones) */
+    BitBoard    threatened[2];  /* same as pair_capture_detector_highlight (the stones of the player threatened by a capture) */
+}               t_pattern_boards;
+
 /* return the positions being a threat of win by opponent (open-threes, fours, fives) */
 BitBoard    get_threat_moves(BitBoard const &p1, BitBoard const &p2, int p2_pairs_captured);
 /* return the positions leading to an instant win */
@@ -127,6 +317,8 @@ BitBoard    win_by_alignment_detector(BitBoard const &p1, BitBoard const &p2, Bi
 BitBoard    three_four_detector(BitBoard const &p1, BitBoard const &p2);
 /* return the positions leading to a double-four (with one stone placed) */
 BitBoard    four_four_detector(BitBoard const &p1, BitBoard const &p2);
+/* return the pattern boards of both players (see t_pattern_boards) walking each direction only once */
+t_pattern_boards    fused_pattern_detector(BitBoard const &p1, BitBoard const &p2);
 
 namespace direction {
     enum direction {
@@ -141,45 +333,138 @@ namespace direction {
     };
 };
 
+/*
+** Compile-time pattern detectors : same as the detectors above, but the pattern is given as template
+** parameters (ex : future_pattern_detector<0xF8, 5, 8>(p1, p2) for OOOOO) so the chain of shifts and
+** intersections is unrolled for each pattern and the cells to intersect with are known at compile time.
+*/
+/* the type of the pattern, 0x80 for the close patterns (which are searched from the p2 stones) */
+constexpr uint8_t   pattern_type(const uint8_t repr, const uint8_t size) {
+    return ((repr & 0x80) | (0x1 << (8-size) & repr));
+}
+
+/*  shift the board step by step in the direction `dir`, keeping the cells matching the pattern at each step
+    (most of the scans end up empty after a few steps, so the remaining steps are skipped)
+*/
+template <uint8_t Repr, uint8_t Size, uint8_t N = 0>
+struct  PatternScan {
+    static BitBoard apply(BitBoard const &tmp, BitBoard const &p1, BitBoard const &open_cells, const uint8_t dir) {
+        const BitBoard  next = tmp.shifted(dir) & ((Repr << N & 0x80) ? p1 : open_cells);
+        return (next.is_empty() ? next : PatternScan<Repr, Size, N + 1>::apply(next, p1, open_cells, dir));
+    }
+};
+
+template <uint8_t Repr, uint8_t Size>
+struct  PatternScan<Repr, Size, Size> {
+    static BitBoard apply(BitBoard const &tmp, BitBoard const &, BitBoard const &, const uint8_t) {
+        return (tmp);
+    }
+};
+
+/* return the cells `Offset` steps before the end of the pattern, in all the directions */
+template <uint8_t Repr, uint8_t Size, uint8_t Dirs, uint8_t Type, uint8_t Offset>
+BitBoard    sub_pattern_scan(BitBoard const &p1, BitBoard const &p2, BitBoard const &open_cells) {
+    BitBoard    res;
+    BitBoard    tmp;
+
+    for (int d = direction::north; d < Dirs; ++d) {
+        tmp = PatternScan<Repr, Size>::apply(Type == 0x80 ? p2 : BitBoard::full, p1, open_cells, d);
+        res |= (Offset ? tmp.shifted_inv(d, Offset) : tmp);
+    }
+    return (res);
+}
+
+/* union of the sub-patterns missing one stone (the stone at index S and the following ones) */
+template <uint8_t Repr, uint8_t Size, uint8_t Dirs, uint8_t S = 0>
+struct  FuturePatternScan {
+    static BitBoard apply(BitBoard const &p1, BitBoard const &p2, BitBoard const &open_cells) {
+        if (Repr & (0x80 >> S))
+            return (sub_pattern_scan<(uint8_t)(Repr & ~(0x80 >> S)), Size, Dirs, pattern_type(Repr, Size), Size-S-1>(p1, p2, open_cells)
+                | FuturePatternScan<Repr, Size, Dirs, S + 1>::apply(p1, p2, open_cells));
+        return (FuturePatternScan<Repr, Size, Dirs, S + 1>::apply(p1, p2, open_cells));
+    }
+};
+
+template <uint8_t Repr, uint8_t Size, uint8_t Dirs>
+struct  FuturePatternScan<Repr, Size, Dirs, Size> {
+    static BitBoard apply(BitBoard const &, BitBoard const &, BitBoard const &) {
+        return (BitBoard());
+    }
+};
+
+template <uint8_t Repr, uint8_t Size, uint8_t Dirs>
+BitBoard    future_pattern_detector(BitBoard const &p1, BitBoard const &p2) {
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
+    return (FuturePatternScan<Repr, Size, Dirs>::apply(p1, p2, open_cells) & ~p1 & ~p2);
+}
+
+template <uint8_t Repr, uint8_t Size, uint8_t Dirs>
+BitBoard    pattern_detector(BitBoard const &p1, BitBoard const &p2) {
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
+    return (sub_pattern_scan<Repr, Size, Dirs, pattern_type(Repr, Size), 0>(p1, p2, open_cells));
+}
+
+template <uint8_t Repr, uint8_t Size, uint8_t Dirs>
+BitBoard    pattern_detector_highlight_open(BitBoard const &p1, BitBoard const &p2) {
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
+    BitBoard        res;
+    BitBoard        tmp;
+
+    for (int d = direction::north; d < Dirs; ++d) {
+        tmp = PatternScan<Repr, Size>::apply(pattern_type(Repr, Size) == 0x80 ? p2 : BitBoard::full, p1, open_cells, d);
+        if (!tmp.is_empty()) {
+            for (int n = 0; n < Size-1; ++n)
+                tmp |= tmp.shifted_inv(d);
+            res |= tmp & open_cells;
+        }
+    }
+    return (res);
+}
+
 #endif
 
-/*     +--19x19 BitBoard-----------------------+
-     0 | . . . . . . . . . . . . . . . . . . . | 0
-     1 | . . . . . . . . . . . . . . . . . . . | 1
-     2 | . . . . . . . . . . . . . . . . . . . | 2
-     3 | . . . . . . ./. . . . . . . . . . . . | 3
-     4 | . . . . . . . . . . . . . . . . . . . | 4
-     5 | . . . . . . . . . . . . . . . . . . . | 5
-     6 | . . . . . . . . . . . . . ./. . . . . | 6
-     7 | . . . . . . . . . . . . . . . . . . . | 7
-     8 | . . . . . . . . . . . . . . . . . . . | 8
-     9 | . . . . . . . . . . . . . . . . . . . | 9
-    10 | . ./. . . . . . . . . . . . . . . . . | 10
-    11 | . . . . . . . . . . . . . . . . . . . | 11
-    12 | . . . . . . . . . . . . . . . . . . . | 12
-    13 | . . . . . . . ./. . . . . . . . . . . | 13
-    14 | . . . . . . . . . . . . . . . . . . . | 14
-    15 | . . . . . . . . . . . . . . . . . . . | 15
-    16 | . . . . . . . . . . . . . . . ./. . . | 16
-    17 | . . . . . . . . . . . . . . . . . . . | 17
-    18 | . . . . . . . . . . . . . . . . . . . | 18
-       +---------------------------------------+
+/*     +--19x19 BitBoard-------------------------+
+     0 | . . . . . . . . . . . . . . . . . . . # | 0
+     1 | . . . . . . . . . . . . . . . . . . . # | 1
+     2 | . . . . . . . . . . . . . . . . . . . # | 2
+     3 | . . . ./. . . . . . . . . . . . . . . # | 3
+     4 | . . . . . . . . . . . . . . . . . . . # | 4
+     5 | . . . . . . . . . . . . . . . . . . . # | 5
+     6 | . . . . . . . ./. . . . . . . . . . . # | 6
+     7 | . . . . . . . . . . . . . . . . . . . # | 7
+     8 | . . . . . . . . . . . . . . . . . . . # | 8
+     9 | . . . . . . . . . . . ./. . . . . . . # | 9
+    10 | . . . . . . . . . . . . . . . . . . . # | 10
+    11 | . . . . . . . . . . . . . . . . . . . # | 11
+    12 | . . . . . . . . . . . . . . . ./. . . # | 12
+    13 | . . . . . . . . . . . . . . . . . . . # | 13
+    14 | . . . . . . . . . . . . . . . . . . . # | 14
+    15 | . . . . . . . . . . . . . . . . . . . # | 15
+    16 |/. . . . . . . . . . . . . . . . . . . # | 16
+    17 | . . . . . . . . . . . . . . . . . . . # | 17
+    18 | . . . . . . . . . . . . . . . . . . . # | 18
+       +-----------------------------------------+
          0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8
 
-    BitBoard without separating bits. The `/` show the separation of
-    the int64 (as the bitboard is represented as an array of 6 int64 variables)
+    BitBoard with a guard bit `#` at the end of each row (stride of 20 bits, 380 bits used).
+    The `/` show the separation of the int64 (as the bitboard is represented as an array of
+    6 int64 variables). A 15x15 board has the same layout with a stride of 16 bits (240 bits
+    used in 4 int64), the shifts being -16, -15, 1, 17, ... instead. The guard bits are always 0 on the stored boards, as long as a board
+    is shifted by one step and then intersected with a board without guard bits (the stones,
+    or the open cells which are computed as `~p1 & ~p2 & BitBoard::full`), stones can't wrap
+    from one side of the board to the other.
 
     +--Shifts---+---------------+-----+
     | direction |     value     | idx |        [indices]         [shifts]
     +-----------+---------------+-----+
-    |     N     |      -19      |  0  |        7   0   1       -20 -19 -18
-    |     S     |       19      |  4  |          ↖︎ ↑ ↗            ↖︎ ↑ ↗
+    |     N     |      -20      |  0  |        7   0   1       -21 -20 -19
+    |     S     |       20      |  4  |          ↖︎ ↑ ↗            ↖︎ ↑ ↗
     |     E     |        1      |  2  |        6 ← ◇ → 2       -1 ← ◇ → +1
     |     W     |       -1      |  6  |          ↙ ↓ ↘︎            ↙ ↓ ↘︎
-    |    N-E    |      -18      |  1  |        5   4   3       +18 +19 +20
-    |    S-E    |       20      |  3  |
-    |    N-W    |      -20      |  7  |        inverse direction :
-    |    S-W    |       18      |  5  |        (dir < 4 ? dir + 4 : dir - 4)
+    |    N-E    |      -19      |  1  |        5   4   3       +19 +20 +21
+    |    S-E    |       21      |  3  |
+    |    N-W    |      -21      |  7  |        inverse direction :
+    |    S-W    |       19      |  5  |        (dir < 4 ? dir + 4 : dir - 4)
     +-----------+---------------+-----+
 
     +--Normal Board------------------+      +--Flipped Board-----------------+
@@ -0,0 +1,45 @@
+#ifndef BITBOARDBATCH_HPP
+# define BITBOARDBATCH_HPP
+
+# include <array>
+# include "BitBoard.hpp"
+
+# define BATCH 8   /* number of boards in a batch (the int64 at one index of all the boards fill two AVX2 registers) */
+
+/*  Structure-of-arrays batch of BATCH BitBoards : the int64 at index i of every board are contiguous
+    (words[i][0..BATCH-1]), so each operation is a loop over the lanes that the compiler turns into SIMD
+    instructions, processing several boards per instruction. It's used to evaluate all the children of
+    a node together, as their boards only differ from each other by a few stones.
+*/
+class BitBoardBatch {
+
+public:
+    BitBoardBatch(void);
+    BitBoardBatch(BitBoard const &board);
+    BitBoardBatch(BitBoardBatch const &src) = default;
+    ~BitBoardBatch(void) = default;
+    BitBoardBatch   &operator=(BitBoardBatch const &rhs) = default;
+
+    void            load(const int k, BitBoard const &board);   // set the board of lane k
+    BitBoard        board(const int k) const;                   // return the board of lane k
+    uint32_t        non_empty(void) const;                      // return a mask with the bit k set if the board of lane k isn't empty
+    std::array<int, BATCH>  set_count(void) const;              // return the number of bits set to 1 on each board
+
+    BitBoardBatch   &shift_and(const uint8_t dir, BitBoardBatch const &mask);  // shift every board by one cell in the direction 'dir' (as BitBoard::shifted) and keep the cells of `mask`
+
+    /* bitwise operators, lane by lane */
+    BitBoardBatch   operator&(BitBoardBatch const &rhs) const;
+    BitBoardBatch   operator|(BitBoardBatch const &rhs) const;
+    BitBoardBatch   operator~(void) const;
+    BitBoardBatch   &operator&=(BitBoardBatch const &rhs);
+    BitBoardBatch   &operator|=(BitBoardBatch const &rhs);
+
+    alignas(32) uint64_t    words[NICB][BATCH];
+};
+
+/* return a mask with the bit k set if p1 has five aligned on lane k (same as `!pattern_detector<0xF8, 5, 4>(p1, p2).is_empty()`) */
+uint32_t        five_detector(BitBoardBatch const &p1);
+/* return the positions leading to a capture, lane by lane (see pair_capture_detector) */
+BitBoardBatch   pair_capture_detector(BitBoardBatch const &p1, BitBoardBatch const &p2);
+
+#endif
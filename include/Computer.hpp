@@ -6,7 +6,7 @@
 class Computer : public Player {
 
 public:
-    Computer(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth);
+    Computer(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth, int threads = 1, int smp_mode = smp::lazy, size_t mcts_mb = MCTS_ARENA_MB, int mcts_policy = selection::uct, size_t tt_mb = TT_SIZE_MB);
     Computer(Computer const &src);
     ~Computer(void);
     Computer	&operator=(Computer const &rhs);
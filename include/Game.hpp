@@ -15,6 +15,11 @@ namespace options {
     typedef struct      s_options {
         int                 depth;
         int                 algo_type;
+        int                 threads;    /* number of threads of the default algorithm (Lazy SMP) and of MCTS */
+        int                 smp;        /* parallel search of the default algorithm (smp::lazy or smp::split) */
+        size_t              mcts_mb;    /* memory cap of the MCTS tree in MB */
+        int                 mcts_policy;/* selection of MCTS (selection::uct or selection::puct) */
+        size_t              tt_mb;      /* size of the transposition table of the default algorithm and of MTDf in MB */
     }                   t_options;
 
     extern t_options       g_optionsp1;
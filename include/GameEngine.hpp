@@ -8,8 +8,8 @@
 # include <Eigen/Dense>
 # include "BitBoard.hpp"
 
-# define BOARD_COLS 19
-# define BOARD_ROWS 19
+# define BOARD_COLS BOARD_SIZE
+# define BOARD_ROWS BOARD_SIZE
 
 class Player;
 
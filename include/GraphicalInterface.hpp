@@ -16,8 +16,8 @@
 # include "ButtonSwitch.hpp"
 # include "ButtonSelect.hpp"
 
-# define COLS 19
-# define ROWS 19
+# define COLS BOARD_SIZE
+# define ROWS BOARD_SIZE
 
 class Player;
 class Game;
@@ -6,7 +6,7 @@
 class Human : public Player {
 
 public:
-    Human(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth);
+    Human(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth, int threads = 1, int smp_mode = smp::lazy, size_t mcts_mb = MCTS_ARENA_MB, int mcts_policy = selection::uct, size_t tt_mb = TT_SIZE_MB);
     Human(Human const &src);
     ~Human(void);
     Human	&operator=(Human const &rhs);
@@ -0,0 +1,68 @@
+#ifndef LINEBOARD_HPP
+# define LINEBOARD_HPP
+
+# include <iostream>
+# include <array>
+# include "BitBoard.hpp"
+
+# define AXES 4     /* number of axes (row, column, diagonal, anti-diagonal) */
+# define LINES (6 * BOARD_SIZE - 2)  /* number of lines on the board (112 on 19x19 : 19 rows, 19 columns, 37 diagonals, 37 anti-diagonals) */
+# define WINDOW 9   /* number of cells of the line windows used to count the patterns */
+# define WINDOWS 19683 /* number of different windows (3^WINDOW, each cell being empty, p1 or p2) */
+
+typedef struct  s_line_pos {
+    uint8_t     line;   /* the index of the line in LineBoard::lines */
+    uint8_t     pos;    /* the position of the cell in the line (the bit index, from the start of the line) */
+}               t_line_pos;
+
+/*  Line-indexed representation of the stones of one player, kept alongside the BitBoard.
+    Each line of the board is encoded in the low bits of an int32 (bit 0 being the first cell
+    of the line), so any line through a cell can be fetched in one load. Placing or removing a
+    stone updates the 4 lines going through its cell.
+*/
+class LineBoard {
+
+public:
+    LineBoard(void);
+    LineBoard(BitBoard const &board);
+    LineBoard(LineBoard const &src) = default;
+    ~LineBoard(void) = default;
+    LineBoard   &operator=(LineBoard const &rhs) = default;
+
+    void        zeros(void);                                    // set all lines to zeros
+    void        write(const int i);                             // place a stone at cell i (BOARD_SIZE * y + x)
+    void        remove(const int i);                            // remove the stone at cell i
+    void        remove(BitBoard const &stones);                 // remove all the given stones (ex : captured stones)
+    uint32_t    line(const int axis, const int i) const;        // return the line along `axis` going through cell i
+    bool        check_bit(const int i) const;                   // check if there is a stone at cell i
+
+    std::array<uint32_t, LINES>                                         lines;
+    static const std::array<std::array<t_line_pos, AXES>, CELLS>        cells;      // the line and position of each cell, for each axis
+    static const std::array<uint8_t, LINES>                             lengths;    // the number of cells of each line
+    static const std::array<std::array<uint16_t, BOARD_SIZE>, LINES>   positions;  // the cell (BOARD_SIZE * y + x) at each position of each line
+};
+
+std::ostream	&operator<<(std::ostream &os, LineBoard const &lineboard);
+
+/* return the number of occurrences of each of the BitBoard::patterns for p1 (the cells beyond the board are read as p2 stones) */
+std::array<int, 8>  pattern_count(LineBoard const &p1, LineBoard const &p2);
+/* same as above, but only on the lines going through the given stones */
+std::array<int, 8>  pattern_count(LineBoard const &p1, LineBoard const &p2, BitBoard const &stones);
+
+/* return the cells of the line n where p1 would complete a free three along the line (the same cells as forbidden_detector finds on one axis) */
+uint32_t    three_cells(LineBoard const &p1, LineBoard const &p2, const int n);
+/* fill `threes` with the three_cells of every line, and return the forbidden cells of p1 (the cells completing a free three on two axes) */
+BitBoard    forbidden_detector(LineBoard const &p1, LineBoard const &p2, std::array<uint32_t, LINES> &threes);
+/* same as above, but only update `threes` and `forbidden` on the lines going through the given stones */
+void        update_forbidden(LineBoard const &p1, LineBoard const &p2, BitBoard const &stones, std::array<uint32_t, LINES> &threes, BitBoard &forbidden);
+
+namespace axis {
+    enum axis {
+        row,            /* west to east, N lines (index 0 to N-1, N being BOARD_SIZE) */
+        column,         /* north to south, N lines (index N to 2N-1) */
+        diagonal,       /* north-west to south-east, 2N-1 lines (index 2N to 4N-2), the first one is the top-right corner */
+        anti_diagonal   /* north-east to south-west, 2N-1 lines (index 4N-1 to 6N-3), the first one is the top-left corner */
+    };
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef MCTSARENA_HPP
+# define MCTSARENA_HPP
+
+# include <cstdint>
+# include <cstddef>
+# include <atomic>
+# include "BitBoard.hpp"
+
+# define MCTS_ARENA_MB 256  /* default memory cap of the MCTS tree in MB */
+
+/*  a node of the MCTS tree, stored in the arena and linked to the other nodes by their index. The childs
+    of a node form a list (first_child, then the next_sibling of each child), a child being pushed at the
+    front of the list when it is expanded. The untried moves are the bits of a BitBoard, a thread expanding
+    the node claims one by clearing its bit. With the PUCT selection, the childs are created all at once by
+    the thread setting `expanding`, in the order of their prior. A node is proven once its outcome is
+    forced (MCTS-Solver).
+*/
+typedef struct  s_mcts_node {
+    std::atomic<int32_t>    wins;           /* number of wins */
+    std::atomic<int32_t>    visit;          /* number of visitation (virtual losses included) */
+    std::atomic<int32_t>    first_child;    /* the last child expanded, -1 if none */
+    int32_t                 next_sibling;   /* the next child of the parent, -1 if none */
+    int32_t                 parent;         /* -1 for the root */
+    int16_t                 move;           /* position played to reach the state of the node */
+    uint8_t                 playerid;
+    std::atomic<bool>       expanding;      /* set by the thread creating all the childs (PUCT) */
+    std::atomic<int8_t>     proven;         /* 1 for a proven win of playerid, -1 for a proven loss, 0 if unknown */
+    int16_t                 childs;         /* number of moves of the node, the number of its childs once fully expanded */
+    float                   prior;          /* probability of the move given by the heuristic (PUCT) */
+    std::atomic<uint64_t>   untried[NICB];  /* the moves not expanded yet (the words of a BitBoard) */
+}               t_mcts_node;
+
+/*  Contiguous store of the MCTS nodes : the nodes are allocated once, up to the number fitting in
+    `size_mb`, and handed out by an atomic counter, so creating a node costs no allocation and the whole
+    tree is freed in O(1) by clear. The nodes are not constructed, create initializes all their fields.
+    A node is always created after its parent, so its index is greater than the index of its parent.
+*/
+class MCTSArena {
+
+public:
+    MCTSArena(size_t size_mb = MCTS_ARENA_MB);
+    ~MCTSArena(void);
+
+    size_t              get_size_mb(void) const { return (this->_size_mb); };
+    size_t              get_capacity(void) const { return (this->_capacity); };
+    size_t              size(void) const;                   // number of nodes created since the last clear
+    void                resize(size_t size_mb);             // reallocate the arena (its nodes are lost)
+    void                clear(void);                        // forget all the nodes
+    int32_t             compact(int32_t root);              // keep only the subtree of `root`, moved to the front of the arena, and return the new index of `root`
+
+    int32_t             create(int32_t parent, int move, BitBoard const &moves);    // return the index of a new node, -1 if the arena is full
+    t_mcts_node         &operator[](int32_t i) { return (this->_nodes[i]); };
+    t_mcts_node const   &operator[](int32_t i) const { return (this->_nodes[i]); };
+
+    int                 claim(int32_t node, uint32_t random);   // clear an untried move of the node (picked from `random`) and return it, -1 if none is left
+    void                release(int32_t node, int move);        // give back a move claimed but not expanded
+    void                add_child(int32_t node, int32_t child); // publish the child in the list of the node
+    bool                is_fully_expanded(int32_t node) const;
+
+private:
+    MCTSArena(MCTSArena const &src);
+    MCTSArena   &operator=(MCTSArena const &rhs);
+
+    t_mcts_node         *_nodes;
+    size_t              _capacity;
+    size_t              _size_mb;
+    std::atomic<size_t> _size;
+};
+
+#endif
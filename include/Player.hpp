@@ -12,7 +12,7 @@ typedef struct  s_action t_action;
 class Player {
 
 public:
-    Player(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth);
+    Player(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth, int threads = 1, int smp_mode = smp::lazy, size_t mcts_mb = MCTS_ARENA_MB, int mcts_policy = selection::uct, size_t tt_mb = TT_SIZE_MB);
     Player(Player const &src);
     virtual ~Player() {};
     Player	&operator=(Player const &rhs);
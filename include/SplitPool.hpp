@@ -0,0 +1,46 @@
+#ifndef SPLITPOOL_HPP
+# define SPLITPOOL_HPP
+
+# include <vector>
+# include <deque>
+# include <mutex>
+# include <thread>
+# include <atomic>
+# include <memory>
+# include <functional>
+
+typedef std::function<void(int worker)>    t_task;    /* a task is given the id of the worker running it */
+
+/*  Work-stealing pool of the split search : each worker owns a deque of tasks, pushes the tasks it
+    splits at its back and runs them back first (the deepest split first), while an idle worker steals
+    the front of the deque of another worker (the oldest, so the largest, task). Worker 0 is the thread
+    that created the pool, the threads-1 other workers are started by the constructor and joined by
+    the destructor. A worker waiting for its tasks runs tasks itself with run_one instead of blocking.
+*/
+class SplitPool {
+
+public:
+    SplitPool(int workers);
+    ~SplitPool(void);
+
+    int         size(void) const { return ((int)this->_queues.size()); };
+    void        push(int worker, t_task const &task);   // add a task to the deque of `worker`
+    bool        run_one(int worker);                    // run a task of `worker`, or steal one, return false if there was none
+
+private:
+    SplitPool(SplitPool const &src);
+    SplitPool   &operator=(SplitPool const &rhs);
+
+    typedef struct  s_queue {
+        std::mutex          lock;
+        std::deque<t_task>  tasks;
+    }               t_queue;
+
+    std::vector<std::unique_ptr<t_queue>>   _queues;
+    std::vector<std::thread>                _threads;
+    std::atomic<bool>                       _quit;
+
+    void        _work(int worker);
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef TRANSPOSITIONTABLE_HPP
+# define TRANSPOSITIONTABLE_HPP
+
+# include <cstdint>
+# include <cstddef>
+# include <atomic>
+# include "ZobristTable.hpp"
+
+# ifndef TT_SIZE_MB
+#  define TT_SIZE_MB 16     /* default size of the transposition table in MB (ex : `-DTT_SIZE_MB=64`) */
+# endif
+# define TT_BUCKET 4        /* number of entries per bucket (4 entries of 16 bytes fill a 64 bytes cache line) */
+# define TT_AGES 64         /* number of distinct ages (the age is stored on 6 bits) */
+
+/*  an entry of the transposition table, packed in 16 bytes : the data word holds the score (bits 0-31), the
+    move (bits 32-47, -1 if none), the depth (bits 48-55) and the bound flag and age (bits 56-63, the flag
+    on the 2 low bits, see ZobristTable::flag). The key word holds the hash xor the data, so an entry torn
+    by two threads writing it at the same time doesn't match its hash anymore and is ignored by probe,
+    and the table can be shared without locks. An entry whose flag and age byte is 0 is empty (the age of
+    a search is never 0).
+*/
+typedef struct  s_tt_entry {
+    std::atomic<uint64_t>   key;    /* the zobrist hash of the position xor data */
+    std::atomic<uint64_t>   data;
+}               t_tt_entry;
+
+typedef struct  alignas(64) s_tt_bucket {
+    t_tt_entry  entries[TT_BUCKET];
+}               t_tt_bucket;
+
+/*  Fixed-size transposition table : a power-of-two number of cache line aligned buckets allocated once,
+    so a probe costs a single cache miss and the memory used never grows. When a bucket is full, the
+    entry replaced is the one with the lowest depth, the entries of the previous searches (older age)
+    being replaced first. probe and store can be called from several threads at the same time.
+*/
+class TranspositionTable {
+
+public:
+    TranspositionTable(size_t size_mb = TT_SIZE_MB);
+    TranspositionTable(TranspositionTable const &src);
+    ~TranspositionTable(void);
+    TranspositionTable  &operator=(TranspositionTable const &rhs);
+
+    size_t      get_size_mb(void) const { return (this->_size_mb); };
+    void        resize(size_t size_mb);                             // reallocate the table (its content is lost)
+    void        clear(void);                                        // empty all the entries
+    void        new_search(void);                                   // start a new search, the entries stored before get older
+
+    bool        probe(uint64_t hash, t_stored &stored) const;       // fill `stored` and return true if the position is in the table
+    void        store(uint64_t hash, int score, int move, int depth, uint8_t flag);
+
+private:
+    t_tt_bucket *_buckets;
+    size_t      _mask;      /* the number of buckets - 1 */
+    size_t      _size_mb;
+    uint8_t     _age;       /* the age of the current search, from 1 to TT_AGES-1 */
+};
+
+#endif
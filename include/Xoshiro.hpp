@@ -0,0 +1,50 @@
+#ifndef XOSHIRO_HPP
+# define XOSHIRO_HPP
+
+# include <cstdint>
+
+/*  xoshiro256** pseudo-random generator : 32 bytes of state and a few shifts per number, so each
+    thread of a search can own one (unlike std::random_device, it costs nothing to draw from). It
+    meets the UniformRandomBitGenerator requirements, so it can be given to std::shuffle.
+*/
+class Xoshiro256 {
+
+public:
+    typedef uint64_t    result_type;
+
+    Xoshiro256(uint64_t seed) {
+        /* the state is filled with splitmix64, so any seed (0 included) gives a valid state */
+        for (int i = 0; i < 4; ++i) {
+            seed += 0x9E3779B97F4A7C15;
+            this->_s[i] = seed;
+            this->_s[i] = (this->_s[i] ^ (this->_s[i] >> 30)) * 0xBF58476D1CE4E5B9;
+            this->_s[i] = (this->_s[i] ^ (this->_s[i] >> 27)) * 0x94D049BB133111EB;
+            this->_s[i] ^= this->_s[i] >> 31;
+        }
+    };
+
+    static constexpr result_type    min(void) { return (0); };
+    static constexpr result_type    max(void) { return (UINT64_MAX); };
+
+    result_type operator()(void) {
+        const uint64_t  res = rotl(this->_s[1] * 5, 7) * 9;
+        const uint64_t  t = this->_s[1] << 17;
+
+        this->_s[2] ^= this->_s[0];
+        this->_s[3] ^= this->_s[1];
+        this->_s[1] ^= this->_s[2];
+        this->_s[0] ^= this->_s[3];
+        this->_s[2] ^= t;
+        this->_s[3] = rotl(this->_s[3], 45);
+        return (res);
+    };
+
+    uint32_t    below(uint32_t n) { return ((uint32_t)(((*this)() >> 32) * n >> 32)); };   // a number in [0, n[
+
+private:
+    uint64_t    _s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return ((x << k) | (x >> (64 - k))); };
+};
+
+#endif
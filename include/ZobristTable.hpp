@@ -3,13 +3,11 @@
 
 # include <iostream>
 # include <cstdlib>
-# include <random>
 # include <array>
-# include <unordered_map>
 # include "BitBoard.hpp"
 
-# define SIZE 361   // the number of cells on the board (19*19)
 # define STATES 3        // the number of states
+# define PAIRS 16        // the number of pairs captured counts that are hashed (more than 5 + 8 pairs can't be reached)
 
 typedef struct  s_stored {
     int         score;
@@ -26,40 +24,21 @@ namespace ZobristTable {
         upperbound
     };
 
-    /* initialization of Zobrist Hashing */
-    static const std::array<std::array<uint64_t, STATES>, SIZE>   _init_zobrist_table_x64(void) {
-        std::array<std::array<uint64_t, STATES>, SIZE> table;
-        /* set up random generator 64-bit */
-        std::random_device  rd;
-        std::mt19937_64     e2(rd());
-        std::uniform_int_distribution<unsigned long long>   dist(std::llround(std::pow(2, 61)), std::llround(std::pow(2, 62)));
+    /* the random value of each state of each cell (defined once in ZobristTable.cpp, so every translation unit hashes the same way) */
+    extern const std::array<std::array<uint64_t, STATES>, CELLS>    _table;
+    /* the random value of each number of pairs captured, for p1 and p2 */
+    extern const std::array<std::array<uint64_t, PAIRS>, 2>         _pairs;
 
-        for (int n = 0; n < SIZE; n++)
-            for (int s = 0; s < STATES; s++)
-                table[n][s] = dist(e2);
-        return (table);
-    }
-    static const std::array<std::array<uint64_t, STATES>, SIZE> _table = _init_zobrist_table_x64();
-
-    /* the key the hashing function will use */
-    struct Key {
-        BitBoard    p1;
-        BitBoard    p2;
+    /* return the hash of the position, the xor of the values of the stones of p1 and p2 and of their pairs captured */
+    static inline uint64_t  hash(BitBoard const &p1, BitBoard const &p2, int p1_pairs_captured, int p2_pairs_captured) {
+        uint64_t    hash = _pairs[0][p1_pairs_captured] ^ _pairs[1][p2_pairs_captured];
 
-        bool operator==(const Key &other) const {
-            return (p1 == other.p1 && p2 == other.p2);
-        }
-    };
-    /* the hashing function that std::unordered_map will use */
-    struct KeyHash {
-        uint64_t operator()(const Key &k) const {
-            uint64_t    hash = 0;
-            for (int n = 0; n < SIZE; ++n)
-                hash ^= _table[n][(!k.p1[n] ? (!k.p2[n] ? 0 : 2) : 1)];
-                // hash ^= _table[n][(k.p1[n]<<(n&0x3F))^(k.p2[n]<<(n&0x3F-1))>>0x3F]; // maybe faster than branching ?
-            return (hash);
-        }
-    };
+        for (int n : p1)
+            hash ^= _table[n][1];
+        for (int n : p2)
+            hash ^= _table[n][2];
+        return (hash);
+    }
 }
 
 #endif
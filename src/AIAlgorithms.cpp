@@ -37,24 +37,20 @@ t_ret       MinMax::minmax(t_node node, int depth, int player) {
     }
     else if (player) {
         best = { -INF, -INF };
-        BitBoard moves = get_moves(node.player, node.opponent, forbidden_detector(node.player, node.opponent), node.player_pairs_captured,
+        BitBoard moves = get_moves(node.player, node.opponent, node.player_forbidden, node.player_pairs_captured,
                                          node.opponent_pairs_captured);
-        for (int i = 0; i < 361; ++i) {
-            if (moves.check_bit(i)) {
-                value = this->minmax(this->create_child(node, i), depth - 1, !player).score;
-                best = value > best.score ? (t_ret){ value, i } : best;
-            }
+        for (int i : moves) {
+            value = this->minmax(this->create_child(node, i), depth - 1, !player).score;
+            best = value > best.score ? (t_ret){ value, i } : best;
         }
     }
     else {
         best = { INF, -INF };
-        BitBoard moves = get_moves(node.opponent, node.player, forbidden_detector(node.opponent, node.player),
+        BitBoard moves = get_moves(node.opponent, node.player, node.opponent_forbidden,
                                          node.opponent_pairs_captured, node.player_pairs_captured);
-        for (int i = 0; i < 361; ++i) {
-            if (moves.check_bit(i)) {
-                value = this->minmax(this->create_child(node, i), depth - 1, !player).score;
-                best = value < best.score ? (t_ret){ value, i } : best;
-            }
+        for (int i : moves) {
+            value = this->minmax(this->create_child(node, i), depth - 1, !player).score;
+            best = value < best.score ? (t_ret){ value, i } : best;
         }
     }
     return (best);
@@ -90,31 +86,27 @@ t_ret       AlphaBeta::alphabeta(t_node node, int depth, int alpha, int beta, in
     }
     else if (player) {
         best = { -INF, -INF };
-        BitBoard moves = get_moves(node.player, node.opponent, forbidden_detector(node.player, node.opponent), node.player_pairs_captured,
+        BitBoard moves = get_moves(node.player, node.opponent, node.player_forbidden, node.player_pairs_captured,
                                          node.opponent_pairs_captured);
-        for (int i = 0; i < 361; ++i) {
-            if (moves.check_bit(i)) {
-                value = this->alphabeta(this->create_child(node, i), depth - 1, alpha, beta, !player).score;
-                best = value > best.score ? (t_ret){ value, i } : best;
-                alpha = this->max(alpha, best.score);
-                if (beta <= alpha) {
-                    break;
-                }
+        for (int i : moves) {
+            value = this->alphabeta(this->create_child(node, i), depth - 1, alpha, beta, !player).score;
+            best = value > best.score ? (t_ret){ value, i } : best;
+            alpha = this->max(alpha, best.score);
+            if (beta <= alpha) {
+                break;
             }
         }
     }
     else {
         best = { INF, -INF };
-        BitBoard moves = get_moves(node.opponent, node.player, forbidden_detector(node.opponent, node.player),
+        BitBoard moves = get_moves(node.opponent, node.player, node.opponent_forbidden,
                                          node.opponent_pairs_captured, node.player_pairs_captured);
-        for (int i = 0; i < 361; ++i) {
-            if (moves.check_bit(i)) {
-                value = this->alphabeta(this->create_child(node, i), depth - 1, alpha, beta, !player).score;
-                best = value < best.score ? (t_ret){ value, i } : best;
-                beta = this->min(beta, best.score);
-                if (beta <= alpha) {
-                    break;
-                }
+        for (int i : moves) {
+            value = this->alphabeta(this->create_child(node, i), depth - 1, alpha, beta, !player).score;
+            best = value < best.score ? (t_ret){ value, i } : best;
+            beta = this->min(beta, best.score);
+            if (beta <= alpha) {
+                break;
             }
         }
     }
@@ -123,11 +115,10 @@ t_ret       AlphaBeta::alphabeta(t_node node, int depth, int alpha, int beta, in
 
 /******************************************************** MTDF ********************************************************/
 
-MTDf::MTDf(int depth, uint8_t pid, uint8_t verbose) : AIPlayer(depth, pid, verbose) {
-    this->_TT.reserve(409600);
+MTDf::MTDf(int depth, uint8_t pid, uint8_t verbose, size_t tt_mb) : AIPlayer(depth, pid, verbose, std::make_shared<TranspositionTable>(tt_mb)) {
 }
 
-MTDf::MTDf(MTDf const &src) : AIPlayer(src.get_depth(), src.get_verbose()) {
+MTDf::MTDf(MTDf const &src) : AIPlayer(src.get_depth(), src._pid, src.get_verbose(), std::make_shared<TranspositionTable>(src._TT->get_size_mb())) {
     *this = src;
 }
 
@@ -144,15 +135,16 @@ t_ret const MTDf::operator()(t_node root) {
 
 /* Alphabeta with memory using transposition table */
 t_ret       MTDf::alphabetawithmemory(t_node node, int depth, int alpha, int beta, int player) {
-    t_stored    bounds;
+    t_stored    stored;
     t_ret       best;
     int         value;
+    uint8_t     flag;
 
     if (this->timesup()) {
         return ((t_ret){ -INF, 0 });
     }
-    if (this->_TT.count({ node.player, node.opponent }) > 0 && this->_TT[{ node.player, node.opponent }].depth >= depth) {
-        t_stored stored = this->_TT[{ node.player, node.opponent }];
+    /* a win is only reused at the same depth, its score being weighted by the depth */
+    if (this->_TT->probe(node_key(node), stored) && (stored.depth == depth || (stored.depth > depth && !is_win_score(stored.score)))) {
         if (stored.flag == ZobristTable::flag::exact) {
             return ((t_ret){ stored.score, stored.move });
         }
@@ -175,46 +167,42 @@ t_ret       MTDf::alphabetawithmemory(t_node node, int depth, int alpha, int bet
     else if (player) {
         best = { -INF, -INF };
         int a = alpha;
-        BitBoard moves = get_moves(node.player, node.opponent, forbidden_detector(node.player, node.opponent), node.player_pairs_captured,
+        BitBoard moves = get_moves(node.player, node.opponent, node.player_forbidden, node.player_pairs_captured,
                                          node.opponent_pairs_captured);
-        for (int i = 0; i < 361; ++i) {
-            if (moves.check_bit(i)) {
-                value = this->alphabetawithmemory(this->create_child(node, i), depth - 1, a, beta, !player).score;
-                best = value > best.score ? (t_ret){ value, i } : best;
-                a = this->max(a, best.score);
-                if (best.score >= beta) {
-                    break;
-                }
+        for (int i : moves) {
+            value = this->alphabetawithmemory(this->create_child(node, i), depth - 1, a, beta, !player).score;
+            best = value > best.score ? (t_ret){ value, i } : best;
+            a = this->max(a, best.score);
+            if (best.score >= beta) {
+                break;
             }
         }
     }
     else {
         best = { INF, -INF };
         int b = beta;
-        BitBoard moves = get_moves(node.opponent, node.player, forbidden_detector(node.opponent, node.player),
+        BitBoard moves = get_moves(node.opponent, node.player, node.opponent_forbidden,
                                          node.opponent_pairs_captured, node.player_pairs_captured);
-        for (int i = 0; i < 361; ++i) {
-            if (moves.check_bit(i)) {
-                value = this->alphabetawithmemory(this->create_child(node, i), depth - 1, alpha, b, !player).score;
-                best = value < best.score ? (t_ret){ value, i } : best;
-                b = this->min(b, best.score);
-                if (best.score <= alpha) {
-                    break;
-                }
+        for (int i : moves) {
+            value = this->alphabetawithmemory(this->create_child(node, i), depth - 1, alpha, b, !player).score;
+            best = value < best.score ? (t_ret){ value, i } : best;
+            b = this->min(b, best.score);
+            if (best.score <= alpha) {
+                break;
             }
         }
     }
 
-    bounds.score = best.score;
-    bounds.move = best.p;
-    bounds.depth = depth;
+    /* the table is kept between the searches, so the scores of an interrupted search are not stored */
+    if (this->timesup())
+        return (best);
     if (best.score <= alpha)
-        bounds.flag = ZobristTable::flag::upperbound;
+        flag = ZobristTable::flag::upperbound;
     else if (best.score >= beta)
-        bounds.flag = ZobristTable::flag::lowerbound;
+        flag = ZobristTable::flag::lowerbound;
     else
-        bounds.flag = ZobristTable::flag::exact;
-    this->_TT[{ node.player, node.opponent }] = bounds;
+        flag = ZobristTable::flag::exact;
+    this->_TT->store(node_key(node), best.score, best.p, depth, flag);
     return (best);
 }
 
@@ -235,6 +223,7 @@ t_ret          MTDf::iterativedeepening(t_node node, int maxdepth) {
     t_ret   g = { 0, 0 };
     t_ret   save;
     this->start = std::chrono::steady_clock::now();
+    this->_TT->new_search();
 
     for (int depth = 1; depth < maxdepth; (depth = depth + 2)) {
         g = this->mtdf(node, g, depth);
@@ -243,7 +232,6 @@ t_ret          MTDf::iterativedeepening(t_node node, int maxdepth) {
         }
         save = g;
     }
-    this->_TT.clear();
     return (save);
 }
 
@@ -257,12 +245,17 @@ bool            MTDf::timesup(void) {
 /************************************************** AlphaBetaCustom ***************************************************/
 
 /* Default algorithm */
-AlphaBetaCustom::AlphaBetaCustom(int depth, uint8_t pid, uint8_t verbose, int time_limit) :  AIPlayer(depth, pid, verbose), _current_max_depth(0), _search_limit_ms(time_limit) {
+AlphaBetaCustom::AlphaBetaCustom(int depth, uint8_t pid, uint8_t verbose, int time_limit, int threads, int mode, size_t tt_mb) :  AIPlayer(depth, pid, verbose, std::make_shared<TranspositionTable>(tt_mb)), _current_max_depth(0), _search_limit_ms(time_limit), _threads(threads), _mode(mode), _helper_id(0), _stop(false), _shared_stop(&this->_stop), _main(this), _pool(nullptr) {
     this->search_stopped = false;
     this->reached_end = false; // NEW
 }
 
-AlphaBetaCustom::AlphaBetaCustom(AlphaBetaCustom const &src) : AIPlayer(src.get_depth(), src.get_verbose()) {
+AlphaBetaCustom::AlphaBetaCustom(AlphaBetaCustom const &main, int helper_id) : AIPlayer(main._depth, main._pid, verbose::quiet, main._TT), _current_max_depth(0), _search_start(main._search_start), _search_limit_ms(main._search_limit_ms), _threads(1), _mode(main._mode), _helper_id(helper_id), _stop(false), _shared_stop(main._shared_stop), _main(main._main), _pool(nullptr) {
+    this->search_stopped = false;
+    this->reached_end = false;
+}
+
+AlphaBetaCustom::AlphaBetaCustom(AlphaBetaCustom const &src) : AIPlayer(src.get_depth(), src._pid, src.get_verbose(), std::make_shared<TranspositionTable>(src._TT->get_size_mb())), _threads(src._threads), _mode(src._mode), _stop(false), _shared_stop(&this->_stop), _main(this), _pool(nullptr) {
     *this = src;
 }
 
@@ -274,16 +267,130 @@ AlphaBetaCustom &AlphaBetaCustom::operator=(AlphaBetaCustom const &rhs) {
     return (*this);
 }
 
-t_ret const     AlphaBetaCustom::operator()(t_node root) { /* iterative deepening */
+/*  Lazy SMP : threads-1 helpers run the same iterative deepening as the main search on their own thread,
+    sharing the transposition table. They start at staggered depths and search the root moves in a different
+    order, so they fill the table with the positions the main search will need next. Only the result of the
+    main search is returned, and every search stops on the shared stop flag.
+*/
+t_ret const     AlphaBetaCustom::operator()(t_node root) {
+    std::vector<std::thread>    helpers;
+    t_ret                       ret;
+
+    this->_stop = false;
+    this->_search_start = std::chrono::steady_clock::now();
+    this->_TT->new_search();
+    if (this->_mode == smp::split)
+        return (this->_split_search(root));
+    for (int id = 1; id < this->_threads; ++id)
+        helpers.push_back(std::thread(&AlphaBetaCustom::_helper_search, this, root, id));
+    ret = this->_iterative_deepening(root, 1);
+    this->_stop = true;
+    for (std::vector<std::thread>::iterator helper = helpers.begin(); helper != helpers.end(); ++helper)
+        helper->join();
+    return (ret);
+}
+
+void            AlphaBetaCustom::_helper_search(t_node root, int helper_id) {
+    AlphaBetaCustom helper(*this, helper_id);
+
+    helper._iterative_deepening(root, (helper_id % 2 ? 3 : 1)); /* half of the helpers skip the first iteration */
+}
+
+/*  Young Brothers Wait : the main thread runs the iterative deepening, and the moves of a node are split
+    between the workers of the pool once its first (eldest) move is searched. The transposition table is
+    not used, so the result only depends on the depth : the score and the move found at a given depth are
+    the same for any number of threads, as long as the time limit isn't reached.
+*/
+t_ret           AlphaBetaCustom::_split_search(t_node root) {
+    std::vector<std::unique_ptr<AlphaBetaCustom>>   workers;
+    SplitPool                                       pool(this->_threads);
+    t_ret                                           ret;
+
+    this->_workers.assign(1, this);
+    for (int id = 1; id < pool.size(); ++id) {
+        workers.push_back(std::unique_ptr<AlphaBetaCustom>(new AlphaBetaCustom(*this, id)));
+        this->_workers.push_back(workers.back().get());
+    }
+    this->_pool = (pool.size() > 1 ? &pool : nullptr);
+    ret = this->_iterative_deepening(root, 1);
+    this->_pool = nullptr;
+    return (ret);
+}
+
+/*  search the moves from `first` (but `skip`) as tasks of the pool, the workers reading and raising the
+    bound shared by the split point when they start and finish a move, and return the best result merged
+    in the order of the moves, as the sequential search would have. The score of each move is stored in
+    its eval, the moves not searched after a cut-off keep the worst score. A move failing low against a
+    bound raised by a younger sibling only has an upper bound : if it could still beat the merged bound,
+    it is searched again with the window of the sequential search.
+*/
+t_ret           AlphaBetaCustom::_split(std::vector<t_move> &moves, size_t first, t_ret best, int alpha, int beta, int depth, int skip, bool maximizing) {
+    AlphaBetaCustom     *main = this->_main;
+    std::atomic<int>    bound(maximizing ? alpha : beta);   /* the alpha (beta) of the split point */
+    std::atomic<bool>   cutoff(false);
+    std::atomic<int>    pending(0);
+    std::vector<int>    started(moves.size());                /* the bound each move was searched with */
+
+    for (size_t i = first; i < moves.size(); ++i) {
+        moves[i].eval = (maximizing ? -INF : INF);
+        if (moves[i].p == skip)
+            continue;
+        pending.fetch_add(1, std::memory_order_relaxed);
+        main->_pool->push(this->_helper_id, [&, i](int worker) {
+            AlphaBetaCustom *search = main->_workers[worker];
+            int             score;
+            int             current;
+
+            if (!cutoff.load(std::memory_order_relaxed)) {
+                started[i] = bound.load(std::memory_order_relaxed);
+                if (maximizing)
+                    score = search->_min(moves[i].node, started[i], beta, depth-1).score;
+                else
+                    score = search->_max(moves[i].node, alpha, started[i], depth-1).score;
+                moves[i].eval = score;
+                current = bound.load(std::memory_order_relaxed);
+                while ((maximizing ? score > current : score < current) && !bound.compare_exchange_weak(current, score, std::memory_order_relaxed))
+                    ;
+                if (maximizing ? score >= beta : score <= alpha)
+                    cutoff.store(true, std::memory_order_relaxed);
+            }
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    /* help the other workers until all the moves of the split point are searched */
+    while (pending.load(std::memory_order_acquire) > 0)
+        if (!main->_pool->run_one(this->_helper_id))
+            std::this_thread::yield();
+    if (this->_shared_stop->load(std::memory_order_relaxed))
+        this->search_stopped = true;
+    for (size_t i = first; i < moves.size() && alpha < beta; ++i) {
+        if (moves[i].p == skip)
+            continue;
+        if (maximizing && !this->search_stopped && alpha < moves[i].eval && moves[i].eval <= started[i])
+            moves[i].eval = this->_min(moves[i].node, alpha, beta, depth-1).score;
+        else if (!maximizing && !this->search_stopped && moves[i].eval < beta && moves[i].eval >= started[i])
+            moves[i].eval = this->_max(moves[i].node, alpha, beta, depth-1).score;
+        if (maximizing && moves[i].eval > best.score) {
+            best = { moves[i].eval, moves[i].p };
+            alpha = this->max(alpha, best.score);
+        }
+        else if (!maximizing && moves[i].eval < best.score) {
+            best = { moves[i].eval, moves[i].p };
+            beta = this->min(beta, best.score);
+        }
+    }
+    return (best);
+}
+
+t_ret           AlphaBetaCustom::_iterative_deepening(t_node root, int first_depth) {
     t_ret       ret = { 0, 0 };
     t_ret       current;
 
     this->search_stopped = false;
     this->reached_end = false; // NEW
-    this->_search_start = std::chrono::steady_clock::now();
     this->_root_moves.clear();
 
-    for (this->_current_max_depth = 1; this->_current_max_depth <= this->_depth; this->_current_max_depth += 2) {
+    for (this->_current_max_depth = first_depth; this->_current_max_depth <= this->_depth; this->_current_max_depth += 2) {
         current = _root_max(root, -INF, INF, this->_current_max_depth);
         _debug_search(current);
         if (this->search_stopped)
@@ -299,23 +406,52 @@ t_ret       AlphaBetaCustom::_min(t_node node, int alpha, int beta, int depth) {
     /* do we exceed our maximum allowed search time */
     if (this->_times_up())
         return ((t_ret){-INF, 0 });
-    /* is the node a leaf or the game is won */
-    if (depth == 0 || this->checkEnd(node))
-        return ((t_ret){ this->score_function(node, depth+1), 0 });
 
+    t_stored            stored;
     t_ret               current;
-    t_ret               best = { INF, 0 };
-    std::vector<t_move> moves = this->move_generation(node, depth);
+    t_ret               best = { INF, -1 };
+    int                 hash_move = -1;
+    std::vector<t_move> moves;
 
-    for (std::vector<t_move>::const_iterator move = moves.begin(); move != moves.end(); ++move) {
-        current = this->_max(move->node, alpha, beta, depth-1);
-        if (current < best) {
-            best = { current.score, move->p };
-            beta = this->min(beta, best.score);
-            if (alpha >= beta) /* alpha cut-off */
-                return (best);
+    /* was the node already searched (at this depth or deeper, a win only at this depth as its score is weighted by the depth) */
+    if (this->_mode == smp::lazy && this->_TT->probe(node_key(node), stored)) {
+        if ((stored.depth == depth || (stored.depth > depth && !is_win_score(stored.score))) && this->_probe_cutoff(stored, alpha, beta))
+            return ((t_ret){ stored.score, stored.move });
+        hash_move = stored.move;
+    }
+    /* is the node a leaf or the game is won */
+    if (depth == 0 || this->checkEnd(node)) {
+        best = { this->score_function(node, depth+1), -1 };
+        this->_store(node, best, -INF, INF, depth);
+        return (best);
+    }
+    const int   window[2] = { alpha, beta };
+    /* the best move of the previous search of the node is searched first, before generating the other moves */
+    if (hash_move >= 0) {
+        current = this->_max(this->create_child(node, hash_move), alpha, beta, depth-1);
+        best = { current.score, hash_move };
+        beta = this->min(beta, best.score);
+    }
+    if (alpha < beta) {
+        moves = this->move_generation(node, depth);
+        for (std::vector<t_move>::const_iterator move = moves.begin(); move != moves.end(); ++move) {
+            if (move->p == hash_move)
+                continue;
+            /* once the eldest move is searched, the younger ones can be split between the threads */
+            if (best.p >= 0 && this->_main->_pool && depth >= SPLIT_DEPTH) {
+                best = this->_split(moves, move - moves.begin(), best, alpha, beta, depth, hash_move, false);
+                break;
+            }
+            current = this->_max(move->node, alpha, beta, depth-1);
+            if (current < best) {
+                best = { current.score, move->p };
+                beta = this->min(beta, best.score);
+                if (alpha >= beta) /* alpha cut-off */
+                    break;
+            }
         }
     }
+    this->_store(node, best, window[0], window[1], depth);
     return (best);
 }
 
@@ -323,47 +459,115 @@ t_ret       AlphaBetaCustom::_max(t_node node, int alpha, int beta, int depth) {
     /* do we exceed our maximum allowed search time */
     if (this->_times_up())
         return ((t_ret){ INF, 0 });
-    /* is the node a leaf or the game is won */
-    if (depth == 0 || this->checkEnd(node))
-        return ((t_ret){ this->score_function(node, depth+1), 0 });
 
+    t_stored            stored;
     t_ret               current;
-    t_ret               best = {-INF, 0 };
-    std::vector<t_move> moves = this->move_generation(node, depth);
+    t_ret               best = {-INF, -1 };
+    int                 hash_move = -1;
+    std::vector<t_move> moves;
 
-    for (std::vector<t_move>::const_iterator move = moves.begin(); move != moves.end(); ++move) {
-        current = this->_min(move->node, alpha, beta, depth-1);
-        _debug_append_explored(current.score, move->p, depth);
-        if (current > best) {
-            best = { current.score, move->p };
-            alpha = this->max(alpha, best.score);
-            if (alpha >= beta) /* beta cut-off */
-                return (best);
+    /* was the node already searched (at this depth or deeper, a win only at this depth as its score is weighted by the depth) */
+    if (this->_mode == smp::lazy && this->_TT->probe(node_key(node), stored)) {
+        if ((stored.depth == depth || (stored.depth > depth && !is_win_score(stored.score))) && this->_probe_cutoff(stored, alpha, beta))
+            return ((t_ret){ stored.score, stored.move });
+        hash_move = stored.move;
+    }
+    /* is the node a leaf or the game is won */
+    if (depth == 0 || this->checkEnd(node)) {
+        best = { this->score_function(node, depth+1), -1 };
+        this->_store(node, best, -INF, INF, depth);
+        return (best);
+    }
+    const int   window[2] = { alpha, beta };
+    /* the best move of the previous search of the node is searched first, before generating the other moves */
+    if (hash_move >= 0) {
+        current = this->_min(this->create_child(node, hash_move), alpha, beta, depth-1);
+        _debug_append_explored(current.score, hash_move, depth);
+        best = { current.score, hash_move };
+        alpha = this->max(alpha, best.score);
+    }
+    if (alpha < beta) {
+        moves = this->move_generation(node, depth);
+        for (std::vector<t_move>::const_iterator move = moves.begin(); move != moves.end(); ++move) {
+            if (move->p == hash_move)
+                continue;
+            /* once the eldest move is searched, the younger ones can be split between the threads */
+            if (best.p >= 0 && this->_main->_pool && depth >= SPLIT_DEPTH) {
+                best = this->_split(moves, move - moves.begin(), best, alpha, beta, depth, hash_move, true);
+                break;
+            }
+            current = this->_min(move->node, alpha, beta, depth-1);
+            _debug_append_explored(current.score, move->p, depth);
+            if (current > best) {
+                best = { current.score, move->p };
+                alpha = this->max(alpha, best.score);
+                if (alpha >= beta) /* beta cut-off */
+                    break;
+            }
         }
     }
+    this->_store(node, best, window[0], window[1], depth);
     return (best);
 }
 
+/*  narrow the window [alpha, beta] with the bound stored in the transposition table, and return true
+    if the stored score can be returned without searching the node
+*/
+bool        AlphaBetaCustom::_probe_cutoff(t_stored const &stored, int &alpha, int &beta) {
+    if (stored.flag == ZobristTable::flag::exact)
+        return (true);
+    else if (stored.flag == ZobristTable::flag::lowerbound)
+        alpha = this->max(alpha, stored.score);
+    else if (stored.flag == ZobristTable::flag::upperbound)
+        beta = this->min(beta, stored.score);
+    return (alpha >= beta);
+}
+
+/* store the result of the search of a node with the window [alpha, beta], unless the search was stopped */
+void        AlphaBetaCustom::_store(t_node const &node, t_ret const &best, int alpha, int beta, int depth) {
+    uint8_t flag = ZobristTable::flag::exact;
+
+    if (this->search_stopped || this->_mode == smp::split)
+        return ;
+    if (best.score <= alpha)
+        flag = ZobristTable::flag::upperbound;
+    else if (best.score >= beta)
+        flag = ZobristTable::flag::lowerbound;
+    this->_TT->store(node_key(node), best.score, best.p, depth, flag);
+}
+
 t_ret       AlphaBetaCustom::_root_max(t_node node, int alpha, int beta, int depth) {
     t_ret       current;
     t_ret       best = {-INF, 0 };
 
     /* if we're at the top of our iterative deepening function */
-    if (this->_current_max_depth == 1)
+    if (this->_root_moves.empty())
         this->_root_moves = this->move_generation(node, depth);
+    /* a helper searches another move first, so the threads don't all search the same subtree */
+    if (this->_helper_id && this->_root_moves.size() > 1)
+        std::swap(this->_root_moves[0], this->_root_moves[this->_helper_id % this->_root_moves.size()]);
 
     /* otherwise the estimation at the previous iterative deepening loop will be used */
     for (std::vector<t_move>::iterator move = this->_root_moves.begin(); move != this->_root_moves.end(); ++move) {
+        if (move != this->_root_moves.begin() && this->_pool && depth >= SPLIT_DEPTH) {
+            best = this->_split(this->_root_moves, move - this->_root_moves.begin(), best, alpha, beta, depth, -1, true);
+            for (; move != this->_root_moves.end(); ++move)
+                _debug_append_explored(move->eval, move->p, depth);
+            break;
+        }
         current = this->_min(move->node, alpha, beta, depth-1);
         move->eval = current.score;
         _debug_append_explored(current.score, move->p, depth);
-        if (std::abs(current.score) >= 1000000) // if we go past we want to stop the iterative deepening
-            this->reached_end = true;
         if (current > best) {
             best = { current.score, move->p };
             alpha = this->max(alpha, best.score);
         }
     }
+    /*  if the best move wins or all the moves lose we want to stop the iterative deepening (the score of
+        the other moves is only an upper bound, a loss found for one of them doesn't end the search)
+    */
+    if (std::abs(best.score) >= 1000000)
+        this->reached_end = true;
     std::sort(this->_root_moves.begin(), this->_root_moves.end(), sort_descending);
     return (best);
 }
@@ -371,7 +575,7 @@ t_ret       AlphaBetaCustom::_root_max(t_node node, int alpha, int beta, int dep
 void    AlphaBetaCustom::_debug_append_explored(int score, int i, int depth) {
     if (this->_verbose >= verbose::normal && depth == this->_current_max_depth) {
         char    tmp[256];
-        std::sprintf(tmp, "  | %2d-%c : %11d pts\n", 19-(i/19), "ABCDEFGHJKLMNOPQRST"[i%19], score);
+        std::sprintf(tmp, "  | %2d-%c : %11d pts\n", BOARD_SIZE-(i/BOARD_SIZE), "ABCDEFGHJKLMNOPQRST"[i%BOARD_SIZE], score);
         this->_debug_string.append(tmp);
     }
 }
@@ -380,8 +584,8 @@ void    AlphaBetaCustom::_debug_search(t_ret const& ret) {
     if (this->_verbose >= verbose::normal) {
         std::printf("[%c] Depth %d: %2d-%c, %11d pts in %3dms\n%s",
             (this->search_stopped ? 'x' : 'o'),
-            this->_current_max_depth, 19-(ret.p/19),
-            "ABCDEFGHJKLMNOPQRST"[ret.p%19],
+            this->_current_max_depth, BOARD_SIZE-(ret.p/BOARD_SIZE),
+            "ABCDEFGHJKLMNOPQRST"[ret.p%BOARD_SIZE],
             ret.score,
             _elapsed_ms(),
             (this->_verbose == verbose::debug ? (this->search_stopped ? "" : this->_debug_string.c_str()) : "")
@@ -391,7 +595,8 @@ void    AlphaBetaCustom::_debug_search(t_ret const& ret) {
 }
 
 bool        AlphaBetaCustom::_times_up(void) {
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->_search_start).count() >= this->_search_limit_ms) {
+    if (this->_shared_stop->load(std::memory_order_relaxed) || std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->_search_start).count() >= this->_search_limit_ms) {
+        this->_shared_stop->store(true, std::memory_order_relaxed);
         this->search_stopped = true;
         return (true);
     }
@@ -404,10 +609,10 @@ int         AlphaBetaCustom::_elapsed_ms(void) {
 
 /******************************************************** MCTS ********************************************************/
 
-MCTS::MCTS(int depth, uint8_t pid, uint8_t verbose, int time_max) : AIPlayer(depth, pid, verbose), _time_max(time_max) {
+MCTS::MCTS(int depth, uint8_t pid, uint8_t verbose, int time_max, int threads, size_t arena_mb, int policy) : AIPlayer(depth, pid, verbose), _time_max(time_max), _threads(threads), _policy(policy), _tree(arena_mb), _root(-1) {
 }
 
-MCTS::MCTS(MCTS const &src) : AIPlayer(src.get_depth(), src.get_verbose()) {
+MCTS::MCTS(MCTS const &src) : AIPlayer(src.get_depth(), src.get_verbose()), _time_max(src._time_max), _threads(src._threads), _policy(src._policy), _tree(src._tree.get_size_mb()), _root(-1) {
     *this = src;
 }
 
@@ -422,51 +627,106 @@ t_ret const MCTS::operator()(t_node root) {
     return (this->mcts(root));
 }
 
-void        MCTS::debugchilds(MCTSNode *root, int level) {
-    MCTSNode    *node = root;
-    if (node->get_parent() == NULL)
-        std::cout << *node << std::endl;
-    std::vector<MCTSNode *>   childs = node->get_childs();
-    for (std::vector<MCTSNode *>::const_iterator child = childs.begin(); child != childs.end(); ++child) {
-        for (int i = 0; i < level; ++i) {
-            std::cout << "--";
-        }
-        std::cout << **child << std::endl;
-        if ((*child)->get_childs().size() != 0) {
-            debugchilds(*child, level + 1);
-        }
-    }
+void        MCTS::debugchilds(int32_t node, int level) {
+    t_mcts_node const   &n = this->_tree[node];
+
+    for (int i = 0; i < level; ++i)
+        std::cout << "--";
+    std::cout << "Node [ move = " << n.move << ", player = " << (int)n.playerid << ", wins = " << n.wins << ", visit = " << n.visit << " ]" << std::endl;
+    for (int32_t child = n.first_child.load(std::memory_order_acquire); child != -1; child = this->_tree[child].next_sibling)
+        this->debugchilds(child, level + 1);
     return ;
 }
 
+/* the moves of the side to move in `state`, the same ones move_generation would return */
+static BitBoard     legal_moves(t_node const &state) {
+    if (state.cid == 1)
+        return (get_moves(state.player, state.opponent, state.player_forbidden, state.player_pairs_captured, state.opponent_pairs_captured));
+    return (get_moves(state.opponent, state.player, state.opponent_forbidden, state.opponent_pairs_captured, state.player_pairs_captured));
+}
+
+/*  Tree-parallel MCTS : threads-1 workers and the calling thread run the iterations on the same tree. A
+    thread adds a virtual loss to the nodes it selects, so the others are steered to other branches until
+    its rollout is backpropagated. The search starts from the subtree of the previous search reaching the
+    root when there is one, otherwise the arena is cleared.
+*/
 t_ret       MCTS::mcts(t_node root_state) {
-    MCTSNode    root_node(NULL, 0, 0, 0, this->move_generation(root_state, 1));
-    MCTSNode    *node_to_explore = &root_node;
-    MCTSNode    *promising_node;
-    t_node      state;
-    int         winner;
+    std::vector<std::thread>    workers;
+    int32_t                     root;
+
+    if ((root = this->reuse_tree(root_state)) == -1) {
+        this->_tree.clear();
+        root = this->_tree.create(-1, 0, (this->_policy == selection::uct ? legal_moves(root_state) : BitBoard::empty));
+    }
+    this->_root = root;
+    this->_root_state = root_state;
     this->_start = std::chrono::steady_clock::now();
+    for (int id = 1; id < this->_threads; ++id)
+        workers.push_back(std::thread(&MCTS::playouts, this, root, std::cref(root_state)));
+    this->playouts(root, root_state);
+    for (std::vector<std::thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker)
+        worker->join();
+    return (this->get_best_move(root));
+}
+
+/*  the root is searched as the grandchild of the previous root reached by the move played (the new stone
+    of the player) and the reply (the new stone of the opponent), or as the previous root itself if the
+    position didn't change. Return -1 when the position wasn't reached by the previous search.
+*/
+int32_t     MCTS::reuse_tree(t_node const &root_state) {
+    BitBoard    played;
+    BitBoard    reply;
+    t_node      state;
+    int32_t     node;
+
+    if (this->_root == -1)
+        return (-1);
+    played = root_state.player & ~this->_root_state.player;
+    reply = root_state.opponent & ~this->_root_state.opponent;
+    if (played.is_empty() && reply.is_empty() && root_state.hash == this->_root_state.hash)
+        return (this->_root);
+    if (played.set_count() != 1 || reply.set_count() != 1)
+        return (-1);
+    state = this->_root_state;
+    node = this->_root;
+    for (int move : { *played.begin(), *reply.begin() }) {
+        for (node = this->_tree[node].first_child.load(std::memory_order_relaxed); node != -1 && this->_tree[node].move != move; node = this->_tree[node].next_sibling)
+            ;
+        if (node == -1)
+            return (-1);
+        state = this->create_child(state, move);
+    }
+    /* the captures of the two moves must match too */
+    if (state.hash != root_state.hash)
+        return (-1);
+    return (this->_tree.compact(node));
+}
+
+void        MCTS::playouts(int32_t root, t_node const &root_state) {
+    std::random_device  random_device;
+    Xoshiro256          rng(((uint64_t)random_device() << 32) | random_device());
+    int32_t             node;
+    int32_t             child;
+    t_node              state;
+    int                 winner;
 
-    while (this->timesup()) {
+    while (this->timesup() && !this->_tree[root].proven.load()) {
         state = root_state;
         /* Tree Policy starts here: */
         /* Select */
-        promising_node = this->select_promising_node(node_to_explore, state);
+        node = this->select_promising_node(root, state);
         /* Expand */
-        if (!((*promising_node).get_untried_actions().empty())) {
-            this->expand_node((*promising_node), state);
-        }
+        if ((child = (this->_policy == selection::uct ? this->expand_node(node, state, rng) : this->expand_ranked(node, state))) != -1)
+            node = child;
         /* Default Policy: */
-        /* Simulate */
-        if (!((*promising_node).get_childs().empty())) {
-            node_to_explore = this->get_random_node((*promising_node));
-            state = this->create_child(state, (*node_to_explore).get_move());
-        }
-        winner = this->rollout(state);
+        /* Simulate (the outcome of a final state is proven) */
+        if ((winner = this->MCTS_check_end(&state)) != 0)
+            this->prove(node, (this->_tree[node].playerid == winner ? 1 : -1));
+        else
+            winner = this->rollout(state, rng);
         /* Backpropagate */
-        node_to_explore = this->backpropagate(node_to_explore, winner);
+        this->backpropagate(node, winner);
     }
-    return (this->get_best_move(root_node));
 }
 
 static double       get_value(int total_visit, double node_wins, int node_visit) {
@@ -475,53 +735,151 @@ static double       get_value(int total_visit, double node_wins, int node_visit)
     return ((double)(node_wins / (double)node_visit) + 1.41 * sqrt(2 * log(total_visit) / node_visit));
 }
 
-static MCTSNode     *get_best_node_with_uct(std::vector<MCTSNode *> childs, int parent_total_visit) {
+/* return the unsolved child of `node` with the best UCT value, -1 if none is published */
+static int32_t      get_best_node_with_uct(MCTSArena const &tree, int32_t node) {
     double          temp_uct;
-    double          best_uct = std::numeric_limits<double>::min();
-    MCTSNode        *best_node = childs[0];
-        
-    for (std::vector<MCTSNode *>::iterator child = childs.begin(); child != childs.end(); ++child) {
-        temp_uct = get_value(parent_total_visit, (*child)->get_wins(), (*child)->get_visit());
+    double          best_uct = std::numeric_limits<double>::lowest();
+    int32_t         best_node = -1;
+    int             parent_total_visit = tree[node].visit.load(std::memory_order_relaxed);
+
+    for (int32_t child = tree[node].first_child.load(std::memory_order_acquire); child != -1; child = tree[child].next_sibling) {
+        if (tree[child].proven.load(std::memory_order_relaxed))
+            continue ;
+        temp_uct = get_value(parent_total_visit, tree[child].wins.load(std::memory_order_relaxed), tree[child].visit.load(std::memory_order_relaxed));
         if (temp_uct > best_uct) {
             best_uct = temp_uct;
-            best_node = *child;
+            best_node = child;
         }
     }
     return (best_node);
 }
 
-MCTSNode            *MCTS::select_promising_node(MCTSNode *root, t_node &state) {
-    MCTSNode        *node = root;
-    while (!(node->get_childs().empty()) && node->get_untried_actions().empty()) {
-        node = get_best_node_with_uct(node->get_childs(), node->get_visit());
-        state = this->create_child(state, node->get_move());
+/*  return the unsolved child of `node` with the best PUCT value among its best ranked ones (more of them
+    being considered as the node is visited), -1 if none is published
+*/
+static int32_t      get_best_node_with_puct(MCTSArena const &tree, int32_t node) {
+    double          temp_puct;
+    double          best_puct = std::numeric_limits<double>::lowest();
+    int32_t         best_node = -1;
+    int             parent_total_visit = tree[node].visit.load(std::memory_order_relaxed);
+    int             width = WIDENING_BASE + (int)pow(parent_total_visit, WIDENING_EXPONENT);
+    int             visit;
+
+    for (int32_t child = tree[node].first_child.load(std::memory_order_acquire); child != -1 && width > 0; child = tree[child].next_sibling) {
+        if (tree[child].proven.load(std::memory_order_relaxed))
+            continue ;
+        --width;
+        visit = tree[child].visit.load(std::memory_order_relaxed);
+        temp_puct = (visit ? (double)tree[child].wins.load(std::memory_order_relaxed) / visit : 0) + PUCT_C * tree[child].prior * sqrt(parent_total_visit) / (1 + visit);
+        if (temp_puct > best_puct) {
+            best_puct = temp_puct;
+            best_node = child;
+        }
     }
-    return (node);
+    return (best_node);
 }
 
-void            MCTS::expand_node(MCTSNode &root, t_node &state) {
-    std::random_device  random_device;
-    std::mt19937        engine{random_device()};
-    std::uniform_int_distribution<int>  dist(0, root.get_untried_actions().size() - 1);
-    int     random = dist(engine);
-
-    t_move move = root.get_untried_actions()[random];
-    state = this->create_child(state, move.p);
-
-    MCTSNode *child = new MCTSNode(&root, move.p, 0, 0, this->move_generation(state, 1));
+/* descend the fully expanded nodes, adding a virtual loss to each node selected (the root included) */
+int32_t             MCTS::select_promising_node(int32_t root, t_node &state) {
+    int32_t         node = root;
+    int32_t         child;
 
-    root.add_child(child);
-    root.remove_action(random);
-
-    return ;
+    this->_tree[node].visit.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+    while ((child = (this->_policy == selection::uct ? (this->_tree.is_fully_expanded(node) ? get_best_node_with_uct(this->_tree, node) : -1) : get_best_node_with_puct(this->_tree, node))) != -1) {
+        node = child;
+        this->_tree[node].visit.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+        state = this->create_child(state, this->_tree[node].move);
+    }
+    return (node);
 }
 
-MCTSNode         *MCTS::get_random_node(MCTSNode &node) {
-    std::random_device  random_device;
-    std::mt19937        engine{random_device()};
-    std::vector<MCTSNode *> childs = node.get_childs();
-    std::uniform_int_distribution<int>  dist(0, childs.size() - 1);
-    return (childs[dist(engine)]);
+/*  expand a random untried move of `node`, return the new child (with its virtual loss) or -1 if there was
+    none left or the arena is full. A final child has no moves and is proven before it is published, so
+    no thread can expand it.
+*/
+int32_t         MCTS::expand_node(int32_t node, t_node &state, Xoshiro256 &rng) {
+    t_node          child_state;
+    int32_t         child;
+    int             move;
+    int             winner;
+
+    if ((move = this->_tree.claim(node, rng())) == -1)
+        return (-1);
+    child_state = this->create_child(state, move);
+    winner = this->MCTS_check_end(&child_state);
+    if ((child = this->_tree.create(node, move, (winner ? BitBoard::empty : legal_moves(child_state)))) == -1) {
+        this->_tree.release(node, move);
+        return (-1);
+    }
+    this->_tree[child].visit.store(VIRTUAL_LOSS, std::memory_order_relaxed);
+    if (winner)
+        this->_tree[child].proven.store(this->_tree[child].playerid == winner ? 1 : -1);
+    this->_tree.add_child(node, child);
+    state = child_state;
+    return (child);
+}
+
+/*  create all the childs of `node` at once, in the order of move_generation, the prior of a move being the
+    softmax of its evaluation (for the side to move) over PUCT_TEMPERATURE. The list is published once
+    complete, then its first child is returned with its virtual loss. Return -1 if another thread expanded
+    the node, if the state is final or if the arena is full.
+*/
+int32_t         MCTS::expand_ranked(int32_t node, t_node &state) {
+    std::vector<t_move> moves;
+    std::vector<double> priors;
+    double              sum = 0;
+    const double        side = (state.cid == 1 ? 1 : -1);
+    int32_t             first = -1;
+    int32_t             last = -1;
+    int32_t             child;
+
+    if (this->_tree[node].expanding.exchange(true, std::memory_order_relaxed) || this->MCTS_check_end(&state))
+        return (-1);
+    moves = this->move_generation(state, 1);
+    for (size_t k = 0; k < moves.size(); ++k) {
+        priors.push_back(exp(std::max(side * ((double)moves[k].eval - moves[0].eval) / PUCT_TEMPERATURE, -50.0)));
+        sum += priors[k];
+    }
+    for (size_t k = 0; k < moves.size(); ++k) {
+        if ((child = this->_tree.create(node, moves[k].p, BitBoard::empty)) == -1)
+            break;
+        this->_tree[child].prior = priors[k] / sum;
+        if (last == -1)
+            first = child;
+        else
+            this->_tree[last].next_sibling = child;
+        last = child;
+    }
+    if (first == -1)
+        return (-1);
+    this->_tree[node].childs = moves.size();
+    this->_tree[first].visit.store(VIRTUAL_LOSS, std::memory_order_relaxed);
+    this->_tree[node].first_child.store(first, std::memory_order_release);
+    state = moves[0].node;
+    return (first);
+}
+
+/*  MCTS-Solver : store the outcome of `node` for its playerid and propagate it to its ancestors. The
+    parent of a proven win is a proven loss (its side to move has a winning move), and a node whose moves
+    all lead to proven losses is a proven win.
+*/
+void            MCTS::prove(int32_t node, int8_t value) {
+    int32_t     parent;
+    int         lost;
+
+    this->_tree[node].proven.store(value);
+    while ((parent = this->_tree[node].parent) != -1) {
+        if (value == -1) {
+            lost = 0;
+            for (int32_t child = this->_tree[parent].first_child.load(std::memory_order_acquire); child != -1; child = this->_tree[child].next_sibling)
+                lost += (this->_tree[child].proven.load() == -1);
+            if (lost < this->_tree[parent].childs)
+                return ;
+        }
+        value = -value;
+        this->_tree[parent].proven.store(value);
+        node = parent;
+    }
 }
 
 int             MCTS::MCTS_check_end(t_node *state) {
@@ -537,57 +895,114 @@ int             MCTS::MCTS_check_end(t_node *state) {
     }
 }
 
-int             MCTS::rollout(t_node state) {
-    t_node      tmp_state = state;
+/*  play the rollout policy until the end of the game, or score the position with the heuristic after
+    ROLLOUT_DEPTH plies (the winner is the side favored by score_function, 2 being the side of node.player
+    as in MCTS_check_end). No move left is a draw.
+*/
+int             MCTS::rollout(t_node state, Xoshiro256 &rng) {
     /* Check if the state is final or not */
-    int         game_status = MCTS_check_end(&tmp_state);
-    /* Generate random move */
-    std::random_device  random_device;
-    std::mt19937        engine{random_device()};
-    std::vector<t_move> moves;
-    t_move              select_move;
-
-    while (game_status == 0) {
-        /* Generate all legal moves from one node/state */
-        moves = this->move_generation(tmp_state, 1);
-        /* Select one random move from this vector list */
-        std::uniform_int_distribution<int>  dist(0, moves.size() - 1);
-        select_move = moves[dist(engine)];
-        tmp_state = this->create_child(tmp_state, select_move.p);
+    int         game_status = MCTS_check_end(&state);
+    int         move;
+    int32_t     score;
+
+    for (int ply = 0; game_status == 0; ++ply) {
+        if (ply == ROLLOUT_DEPTH) {
+            score = this->score_function(state, 1);
+            return (score > 0 ? 2 : (score < 0 ? 1 : 0));
+        }
+        if ((move = this->rollout_move(state, rng)) == -1)
+            return (0);
+        state = this->create_child(state, move);
         /* Check if this move terminate the play */
-        game_status = MCTS_check_end(&tmp_state);
+        game_status = MCTS_check_end(&state);
     }
     return (game_status);
 }
 
-MCTSNode        *MCTS::backpropagate(MCTSNode *leaf, int winner) {
-    MCTSNode    *node_tmp = leaf;
+/* return the cell of `cells` of rank `k` (in the order of the BitBoard iterator) */
+static int      select_cell(BitBoard const &cells, int k) {
+    uint64_t    bits;
+    int         count;
+
+    for (int w = 0; w < NICB; ++w) {
+        bits = cells.word(w);
+        if (k >= (count = __builtin_popcountll(bits))) {
+            k -= count;
+            continue;
+        }
+        for (; k > 0; --k)
+            bits &= ~(0x8000000000000000 >> __builtin_clzll(bits));
+        return (BitBoard::bit_to_cell((w << 6) + __builtin_clzll(bits)));
+    }
+    return (-1);
+}
+
+/*  the rollout policy : break a five of the opponent by a capture, otherwise complete a five (or win by
+    capture), otherwise block a five of the opponent, otherwise a random move next to the stones. Only a
+    few detectors are run per ply, instead of a full move_generation.
+*/
+int             MCTS::rollout_move(t_node const &state, Xoshiro256 &rng) {
+    BitBoard const  &me = (state.cid == 1 ? state.player : state.opponent);
+    BitBoard const  &them = (state.cid == 1 ? state.opponent : state.player);
+    const int       my_pairs = (state.cid == 1 ? state.player_pairs_captured : state.opponent_pairs_captured);
+    const BitBoard  empty = BitBoard(~me & ~them & BitBoard::full);
+    BitBoard        moves;
+
+    if (detect_five_aligned(them))
+        moves = pair_capture_breaking_five_detector(me, them) & empty;
+    if (moves.is_empty()) {
+        moves = future_pattern_detector<0xF8, 5, 8>(me, them) & empty; // OOOOO
+        if (my_pairs >= 3) /* a move can capture two pairs */
+            moves |= win_by_capture_detector(me, them, my_pairs) & empty;
+    }
+    if (moves.is_empty())
+        moves = future_pattern_detector<0xF8, 5, 8>(them, me) & empty; // OOOOO
+    if (moves.is_empty()) {
+        moves = BitBoard(me | them).dilated() & empty & ~(state.cid == 1 ? state.player_forbidden : state.opponent_forbidden);
+        if (moves.is_empty() && me.is_empty() && them.is_empty())
+            moves.write(BOARD_SIZE / 2, BOARD_SIZE / 2);
+    }
+    if (moves.is_empty())
+        return (-1);
+    return (select_cell(moves, rng.below(moves.set_count())));
+}
+
+/* count the visit of each node from the leaf to the root, replacing the virtual loss added by the selection */
+int32_t         MCTS::backpropagate(int32_t leaf, int winner) {
+    int32_t     node_tmp = leaf;
     while (true) {
-        node_tmp->inc_visit();
-        if (node_tmp->get_playerid() == winner) {
-            node_tmp->inc_wins(1);
+        this->_tree[node_tmp].visit.fetch_add(1 - VIRTUAL_LOSS, std::memory_order_relaxed);
+        if (this->_tree[node_tmp].playerid == winner) {
+            this->_tree[node_tmp].wins.fetch_add(1, std::memory_order_relaxed);
         }
-        if (node_tmp->get_parent() == NULL) {
+        if (this->_tree[node_tmp].parent == -1) {
             break;
         }
-        node_tmp = node_tmp->get_parent();
+        node_tmp = this->_tree[node_tmp].parent;
     }
     return (node_tmp);
 }
 
-t_ret           MCTS::get_best_move(MCTSNode &root_node) {
-    std::vector<MCTSNode *> childs = root_node.get_childs();
-    MCTSNode                *best_node = childs[0];
-    double                  best_score = -1;
-    double                  expect_success;
-    for (std::vector<MCTSNode *>::const_iterator child = childs.begin(); child != childs.end(); ++child) {
-        expect_success = (double)((*child)->get_wins() + 1) / ((*child)->get_visit() + 2);
+t_ret           MCTS::get_best_move(int32_t root) {
+    int32_t     best_node = -1;
+    double      best_score = -1;
+    double      expect_success;
+
+    for (int32_t child = this->_tree[root].first_child.load(std::memory_order_acquire); child != -1; child = this->_tree[child].next_sibling) {
+        /* a proven win first, a proven loss last, otherwise the most visited child with PUCT (the childs
+           of a low prior being barely visited) */
+        if (this->_tree[child].proven)
+            expect_success = (this->_tree[child].proven == 1 ? std::numeric_limits<double>::max() : -0.5);
+        else if (this->_policy == selection::puct)
+            expect_success = this->_tree[child].visit;
+        else
+            expect_success = (double)(this->_tree[child].wins + 1) / (this->_tree[child].visit + 2);
         if (expect_success > best_score) {
             best_score = expect_success;
-            best_node = *child;
+            best_node = child;
         }
     }
-    return ((t_ret){ 0, best_node->get_move() });
+    return ((t_ret){ 0, (best_node != -1 ? this->_tree[best_node].move : -1) });
 }
 
 bool            MCTS::timesup(void) {
@@ -596,67 +1011,3 @@ bool            MCTS::timesup(void) {
     }
     return (false);
 }
-
-MCTSNode::MCTSNode(MCTSNode *parent, int move, int wins, int visit, std::vector<t_move> moves): _parent(parent), _move(move), _wins(wins), _visit(visit) {
-    this->_untried_actions = moves;
-    if (this->_parent != NULL && this->_parent->get_playerid() == 1) {
-        this->_playerid = 2;
-    } else {
-        this->_playerid = 1;
-    }
-}
-
-MCTSNode::MCTSNode(MCTSNode const &src) {
-    *this = src;
-}
-
-MCTSNode::~MCTSNode(void) {
-    for (MCTSNode* child : _childs) {
-        delete child;
-    }
-}
-
-MCTSNode	&MCTSNode::operator=(MCTSNode const &rhs) {
-    this->_parent = rhs.get_parent();
-    this->_playerid = rhs.get_playerid();
-    this->_move = rhs.get_move();
-    this->_wins = rhs.get_wins();
-    this->_visit = rhs.get_visit();
-    this->_childs = rhs.get_childs();
-    this->_untried_actions = rhs.get_untried_actions();
-    return (*this);
-}
-
-void        MCTSNode::add_child(MCTSNode *node) {
-    this->_childs.push_back(node);
-    return ;
-}
-
-void        MCTSNode::remove_action(int index) {
-    this->_untried_actions.erase(this->_untried_actions.begin() + index);
-    return ;
-}
-
-
-std::ostream &operator<<(std::ostream &o, const MCTSNode &rhs) {
-    std::stringstream   ss;
-
-    if (rhs.get_parent() != NULL)
-        ss << "Node [ parent\t= " << std::to_string(rhs.get_parent()->get_move()) << "\t]\n";
-    else
-        ss << "Node [ root node ]\n";
-    ss << "     [ player\t= " << std::to_string(rhs.get_playerid()) << "\t]\n";
-    ss << "     [ move\t= " << std::to_string(rhs.get_move()) << "\t]\n";
-    ss << "     [ wins\t= " << std::to_string(rhs.get_wins()) << "\t]\n";
-    ss << "     [ visit\t= " << std::to_string(rhs.get_visit()) << "\t]\n";
-    if (rhs.get_childs().size() > 0)
-        ss << "     [ childs\t= " << std::to_string(rhs.get_childs().size()) << "\t]\n";
-    else
-        ss << "     [ childs\t= 0" << "\t]\n";
-    if (rhs.get_untried_actions().size() > 0)
-        ss << "     [ actions\t= " << std::to_string(rhs.get_untried_actions().size()) << "\t]";
-    else
-        ss << "     [ actions\t= 0" << "\t]";
-    o << ss.str();
-	return o;
-}
@@ -2,10 +2,14 @@
 #include "Player.hpp"
 #include "GameEngine.hpp"
 
-AIPlayer::AIPlayer(int depth, uint8_t pid, uint8_t verbose) : _depth(depth), _verbose(verbose), _pid(pid) {
+/* the transposition table is only allocated by the searches probing it (MTDf and AlphaBetaCustom) */
+AIPlayer::AIPlayer(int depth, uint8_t pid, uint8_t verbose) : _TT(nullptr), _depth(depth), _verbose(verbose), _pid(pid) {
 }
 
-AIPlayer::AIPlayer(AIPlayer const &src) {
+AIPlayer::AIPlayer(int depth, uint8_t pid, uint8_t verbose, std::shared_ptr<TranspositionTable> const &tt) : _TT(tt), _depth(depth), _verbose(verbose), _pid(pid) {
+}
+
+AIPlayer::AIPlayer(AIPlayer const &src) : _TT(src._TT ? std::make_shared<TranspositionTable>(src._TT->get_size_mb()) : nullptr) {
     *this = src;
 }
 
@@ -14,16 +18,35 @@ AIPlayer        &AIPlayer::operator=(AIPlayer const&) {
 }
 
 t_node      create_node(Player const& player, Player const& opponent) {
-    t_node  node;
+    t_node                      node;
+    std::list<t_action> const   *history = player.get_game_engine()->get_history();
 
     node.player = player.board;
     node.opponent = opponent.board;
+    node.player_lines = LineBoard(player.board);
+    node.opponent_lines = LineBoard(opponent.board);
+    node.player_patterns = pattern_count(node.player_lines, node.opponent_lines);
+    node.opponent_patterns = pattern_count(node.opponent_lines, node.player_lines);
+    node.player_forbidden = forbidden_detector(node.player_lines, node.opponent_lines, node.player_threes);
+    node.opponent_forbidden = forbidden_detector(node.opponent_lines, node.player_lines, node.opponent_threes);
     node.cid = 1;
     node.player_pairs_captured = player.get_pairs_captured();
     node.opponent_pairs_captured = opponent.get_pairs_captured();
+    node.hash = ZobristTable::hash(node.player, node.opponent, node.player_pairs_captured, node.opponent_pairs_captured);
+    /* the last move played (check_end and node_key depend on it when a five is on the board), CELLS if none */
+    node.move = (history->empty() ? CELLS : history->back().pos[0] * BOARD_SIZE + history->back().pos[1]);
     return (node);
 }
 
+/*  the key of a node in the transposition table : the hash of its stones, and of its last move when a five
+    is on the board (check_end then depends on the move that made it, a five can still be broken by a capture)
+*/
+uint64_t    node_key(t_node const& node) {
+    if ((node.player_patterns[0] || node.opponent_patterns[0]) && node.move < CELLS)
+        return (node.hash ^ ZobristTable::_table[node.move][0]);
+    return (node.hash);
+}
+
 BitBoard    get_moves(BitBoard const& player, BitBoard const& opponent, BitBoard const& player_forbidden, int player_pairs_captured, int opponent_pairs_captured) {
     BitBoard    moves;
 
@@ -32,7 +55,7 @@ BitBoard    get_moves(BitBoard const& player, BitBoard const& opponent, BitBoard
         if (!opponent.is_empty()) /* if opponent has stones */
             moves |= opponent.dilated() & ~player; /* dilate around opponent */
         else /* if the board is totally empty */
-            moves.write(9, 9);
+            moves.write(BOARD_SIZE / 2, BOARD_SIZE / 2);
         return (moves & ~player & ~opponent);
     }
     /* if opponent has five aligned, we want to play the counter move */
@@ -50,22 +73,22 @@ BitBoard    get_moves(BitBoard const& player, BitBoard const& opponent, BitBoard
     /* if opponent can win next turn, only explore the moves that will try to prevent that */
     moves = get_winning_moves(opponent, player, opponent_pairs_captured, player_pairs_captured);
     if (!moves.is_empty())
-        return (moves | future_pattern_detector(player, opponent, { 0xF8, 5, 8, 0, 0 })); // OOOOO
+        return (moves | future_pattern_detector<0xF8, 5, 8>(player, opponent)); // OOOOO
     /* opponent threats of open-threes, five-alignments and captures */
     moves |= get_threat_moves(player, opponent, opponent_pairs_captured);
     moves |= pair_capture_detector(opponent, player);
     /* explore building fives (non-instant win), open-fours, pair captures and opponent stone capture threats */
-    moves |= future_pattern_detector(player, opponent, { 0xF8, 5, 8, 0, 0 }); // OOOOO
-    moves |= future_pattern_detector(player, opponent, { 0x78, 6, 8, 0, 0 }); // -OOOO-
+    moves |= future_pattern_detector<0xF8, 5, 8>(player, opponent); // OOOOO
+    moves |= future_pattern_detector<0x78, 6, 8>(player, opponent); // -OOOO-
     moves |= pair_capture_detector(player, opponent);
     /* explore building open-threes */
     if (moves.set_count() <= 4) {
-        moves |= pattern_detector_highlight_open(opponent, player, { 0x60, 4, 4, 0, 0 }); // -OO-, threatening capture of opponent stones
-        moves |= future_pattern_detector(player, opponent, { 0x70, 5, 8, 0, 0 }); // -OOO-
-        moves |= future_pattern_detector(player, opponent, { 0x68, 6, 8, 0, 0 }); // -OO-O-
+        moves |= pattern_detector_highlight_open<0x60, 4, 4>(opponent, player); // -OO-, threatening capture of opponent stones
+        moves |= future_pattern_detector<0x70, 5, 8>(player, opponent); // -OOO-
+        moves |= future_pattern_detector<0x68, 6, 8>(player, opponent); // -OO-O-
         /* explore building close-four (to delay by one turn), is it necessary ? seems a bit like a bitch move */
         if (moves.set_count() <= 4) {
-            moves |= future_pattern_detector(player, opponent, { 0xF0, 5, 8, 0, 0 }); // |OOOO-
+            moves |= future_pattern_detector<0xF0, 5, 8>(player, opponent); // |OOOO-
             if (moves.set_count() <= 2)
                 moves |= player.dilated() & ~opponent; /* dilate around player */
         }
@@ -73,164 +96,210 @@ BitBoard    get_moves(BitBoard const& player, BitBoard const& opponent, BitBoard
     return (moves & ~player & ~opponent & ~player_forbidden);
 }
 
+/* update the pattern counts of a child, only on the lines going through the played and the captured stones */
+static inline void  update_pattern_count(t_node const &parent, t_node &child, BitBoard const &touched) {
+    const std::array<int, 8>    player_before = pattern_count(parent.player_lines, parent.opponent_lines, touched);
+    const std::array<int, 8>    player_after = pattern_count(child.player_lines, child.opponent_lines, touched);
+    const std::array<int, 8>    opponent_before = pattern_count(parent.opponent_lines, parent.player_lines, touched);
+    const std::array<int, 8>    opponent_after = pattern_count(child.opponent_lines, child.player_lines, touched);
+
+    for (int n = 0; n < 8; ++n) {
+        child.player_patterns[n] += player_after[n] - player_before[n];
+        child.opponent_patterns[n] += opponent_after[n] - opponent_before[n];
+    }
+}
+
 t_node          AIPlayer::create_child(t_node const &parent, int i) {
-    t_node  child = parent;
+    t_node      child = parent;
+    BitBoard    captured;
+
     child.move = i;
     /* simulate player move */
     if (child.cid == 1) {
         child.player.write(i);
-        BitBoard captured = highlight_captured_stones(child.player, child.opponent, i);
+        child.player_lines.write(i);
+        child.hash ^= ZobristTable::_table[i][1];
+        captured = highlight_captured_stones(child.player, child.opponent, i);
         if (!captured.is_empty()) {
+            child.hash ^= ZobristTable::_pairs[0][child.player_pairs_captured];
             child.player_pairs_captured += captured.set_count() / 2;
+            child.hash ^= ZobristTable::_pairs[0][child.player_pairs_captured];
             child.opponent &= ~captured;
+            child.opponent_lines.remove(captured);
+            for (int c : captured)
+                child.hash ^= ZobristTable::_table[c][2];
         }
         child.cid = 2;
     }/* simulate opponent move */
     else {
         child.opponent.write(i);
-        BitBoard captured = highlight_captured_stones(child.opponent, child.player, i);
+        child.opponent_lines.write(i);
+        child.hash ^= ZobristTable::_table[i][2];
+        captured = highlight_captured_stones(child.opponent, child.player, i);
         if (!captured.is_empty()) {
+            child.hash ^= ZobristTable::_pairs[1][child.opponent_pairs_captured];
             child.opponent_pairs_captured += captured.set_count() / 2;
+            child.hash ^= ZobristTable::_pairs[1][child.opponent_pairs_captured];
             child.player &= ~captured;
+            child.player_lines.remove(captured);
+            for (int c : captured)
+                child.hash ^= ZobristTable::_table[c][1];
         }
         child.cid = 1;
     }
+    captured.write(i);
+    update_pattern_count(parent, child, captured);
+    update_forbidden(child.player_lines, child.opponent_lines, captured, child.player_threes, child.player_forbidden);
+    update_forbidden(child.opponent_lines, child.player_lines, captured, child.opponent_threes, child.opponent_forbidden);
     return (child);
 }
 
-static inline int   popcount64(uint64_t x) {
-    x = x - ((x >> 1) & 0x5555555555555555);
-    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
-    return (((x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F) * 0x0101010101010101) >> 56;
-}
-
 std::vector<t_move> AIPlayer::move_generation(t_node const& node, int depth) {
     std::vector<t_move> serialized;
     BitBoard            moves;
 
     /* compute the moves to explore for the given player */
     if (node.cid == 1)
-        moves = get_moves(node.player, node.opponent, forbidden_detector(node.player, node.opponent), node.player_pairs_captured, node.opponent_pairs_captured);
+        moves = get_moves(node.player, node.opponent, node.player_forbidden, node.player_pairs_captured, node.opponent_pairs_captured);
     else
-        moves = get_moves(node.opponent, node.player, forbidden_detector(node.opponent, node.player), node.opponent_pairs_captured, node.player_pairs_captured);
+        moves = get_moves(node.opponent, node.player, node.opponent_forbidden, node.opponent_pairs_captured, node.player_pairs_captured);
     /* convert the bitboard of moves to a list of positions */
-    for (int i = 0; i < NICB; ++i)
-        if (moves.values[i]) do {
-            int idx = 63 - popcount64((moves.values[i] & -moves.values[i]) - 1) + (BITS * i);
-            t_node move = this->create_child(node, idx);
-            serialized.push_back((t_move){ this->evaluation_function(move, depth), idx, move });
-        } while (moves.values[i] &= moves.values[i] - 1);
+    for (int i : moves)
+        serialized.push_back((t_move){ 0, i, this->create_child(node, i) });
+    this->evaluation_function(serialized, depth);
     /* sort the elements in the list by score */
     std::sort(serialized.begin(), serialized.end(), (node.cid == 2 ? sort_ascending : sort_descending));
     return (serialized);
 }
 
-static inline int32_t   player_score(t_node const &node, uint8_t depth) {
-    BitBoard    board;
-    BitBoard    captb;
-    int64_t     score = 0;
-    int64_t     count;
-    int         value;
+/*  return the pattern counts once the stones threatened by a capture are removed from p1, only the lines
+    going through these stones are counted again.
+*/
+static inline std::array<int, 8>    counts_without(std::array<int, 8> counts, LineBoard const &p1, LineBoard const &p2, BitBoard const &threatened) {
+    LineBoard           remaining = p1;
+    std::array<int, 8>  before;
+    std::array<int, 8>  after;
+
+    if (threatened.is_empty())
+        return (counts);
+    remaining.remove(threatened);
+    before = pattern_count(p1, p2, threatened);
+    after = pattern_count(remaining, p2, threatened);
+    for (int i = 0; i < 8; ++i)
+        counts[i] += after[i] - before[i];
+    return (counts);
+}
+
+static inline int32_t   player_score(t_node const &node, uint8_t depth, t_pattern_boards const &boards) {
+    BitBoard            board;
+    std::array<int, 8>  safe;
+    int64_t             score = 0;
+    int64_t             count;
+    int                 value;
 
     /* return a score for a win by capture, weighted with the depth at which the win is found */
     if (node.player_pairs_captured >= 5)
-        return (50000000 * depth);
+        return (WIN_SCORE * depth);
     /* return a score for a win by alignment (unbreakable) */
-    board = highlight_five_aligned(node.player ^ pair_capture_detector_highlight(node.opponent, node.player));
+    board = highlight_five_aligned(node.player ^ boards.threatened[0]);
     if (!board.is_empty() && win_by_capture_detector(node.opponent, node.player, node.opponent_pairs_captured).is_empty())
-        return (50000000 * depth);
+        return (WIN_SCORE * depth);
     /* three-four if they are not threatened by a capture are sure win in 2 extra moves */
-    board = three_four_detector(node.player, node.opponent);
+    board = boards.three_four[0];
     score += (board.is_empty() == false ? board.set_count() * (node.cid == 2 ? 500 : 1000) : 0);
     /* four-four if they are not threatened by a capture are sure win in 1 extra move */
-    board = four_four_detector(node.player, node.opponent);
+    board = boards.four_four[0];
     score += (board.is_empty() == false ? board.set_count() * (node.cid == 2 ? 750 : 1200) : 0);
     /* count the score for all the patterns we find, and apply penalty for those that are threatened by capture */
+    safe = counts_without(node.player_patterns, node.player_lines, node.opponent_lines, boards.threatened[0]);
     for (int i = 0; i < 8; ++i) {
         value = (node.cid == 2 ? BitBoard::patterns[i].value_0 : BitBoard::patterns[i].value_1);
-        board = pattern_detector(node.player, node.opponent, BitBoard::patterns[i]);
-        captb = pattern_detector(pair_capture_detector_highlight(node.opponent, node.player) ^ node.player, node.opponent, BitBoard::patterns[i]);
-        count = (captb.is_empty() == false ? captb.set_count() : 0);
-        score += (int64_t)((board.set_count() - count) * value * 0.25 + count * value);
+        count = safe[i];
+        score += (int64_t)((node.player_patterns[i] - count) * value * 0.25 + count * value);
     }
-    score += pair_capture_detector(node.player, node.opponent).set_count() * (node.cid == 2 ? 3 : 10);/* evaluate opponent pair threatening */
+    score += boards.captures[0].set_count() * (node.cid == 2 ? 3 : 10);/* evaluate opponent pair threatening */
     score += node.player_pairs_captured * node.player_pairs_captured * 20;      /* evaluate the pairs captured [0, 100, 400, 900, 1600, 2500] */
     return (score);
 }
 
-static inline int32_t   opponent_score(t_node const &node, uint8_t depth, uint8_t pid) {
-    BitBoard    board;
-    BitBoard    captb;
-    int64_t     score = 0;
-    int64_t     count;
-    int         value;
+static inline int32_t   opponent_score(t_node const &node, uint8_t depth, uint8_t pid, t_pattern_boards const &boards) {
+    BitBoard            board;
+    std::array<int, 8>  safe;
+    int64_t             score = 0;
+    int64_t             count;
+    int                 value;
 
     /* return a score for a win by capture, weighted with the depth at which the win is found */
     if (node.opponent_pairs_captured >= 5)
-        return (50000000 * depth);
+        return (WIN_SCORE * depth);
     /* return a score for a win by alignment (unbreakable) */
-    board = highlight_five_aligned(node.opponent ^ pair_capture_detector_highlight(node.player, node.opponent));
+    board = highlight_five_aligned(node.opponent ^ boards.threatened[1]);
     if (!board.is_empty() && win_by_capture_detector(node.player, node.opponent, node.player_pairs_captured).is_empty())
-        return (50000000 * depth);
+        return (WIN_SCORE * depth);
     /* three-four if they are not threatened by a capture are sure win in 2 extra moves */
-    board = three_four_detector(node.opponent, node.player);
+    board = boards.three_four[1];
     score += (board.is_empty() == false ? board.set_count() * (node.cid == 1 ? 500 : 1000) : 0);
     /* four-four if they are not threatened by a capture are sure win in 1 extra move */
-    board = four_four_detector(node.opponent, node.player);
+    board = boards.four_four[1];
     score += (board.is_empty() == false ? board.set_count() * (node.cid == 1 ? 750 : 1200) : 0);
     /* count the score for all the patterns we find, and apply penalty for those that are threatened by capture */
+    safe = counts_without(node.opponent_patterns, node.opponent_lines, node.player_lines, boards.threatened[1]);
     for (int i = 0; i < 8; ++i) {
         value = (node.cid == 1 ? BitBoard::patterns[i].value_0 : BitBoard::patterns[i].value_1);
         value += (pid == 1 ? BitBoard::p1_pattern_weights[i] : BitBoard::p2_pattern_weights[i]); /* dynamic pattern weighing */
-        board = pattern_detector(node.opponent, node.player, BitBoard::patterns[i]);
-        captb = pattern_detector(pair_capture_detector_highlight(node.player, node.opponent) ^ node.opponent, node.player, BitBoard::patterns[i]);
-        count = (captb.is_empty() == false ? captb.set_count() : 0);
-        score += (int64_t)((board.set_count() - count) * value * 0.25 + count * value);
+        count = safe[i];
+        score += (int64_t)((node.opponent_patterns[i] - count) * value * 0.25 + count * value);
     }
-    score += pair_capture_detector(node.opponent, node.player).set_count() * (node.cid == 1 ? 3 : 10);/* evaluate opponent pair threatening */
+    score += boards.captures[1].set_count() * (node.cid == 1 ? 3 : 10);/* evaluate opponent pair threatening */
     score += node.opponent_pairs_captured * node.opponent_pairs_captured * 20;      /* evaluate the pairs captured [0, 100, 400, 900, 1600, 2500] */
     return (score);
 }
 
 int32_t         AIPlayer::score_function(t_node const &node, uint8_t depth) {
-    int64_t     score = 0;
+    const t_pattern_boards  boards = fused_pattern_detector(node.player, node.opponent);
+    int64_t                 score = 0;
 
-    score += player_score(node, depth);
-    score -= (int64_t)(opponent_score(node, depth, this->_pid) * 1.5); // we give more weight to defense
+    score += player_score(node, depth, boards);
+    score -= (int64_t)(opponent_score(node, depth, this->_pid, boards) * 1.5); // we give more weight to defense
     return ((int32_t)range(score, (int64_t)-INF, (int64_t)INF));
 }
 
-static inline int64_t   player_evaluation(t_node const &node, uint8_t depth) {
-    int64_t     score = 0;
-
-    if (node.player_pairs_captured >= 5)
-        return (50000000 * depth);
-    if (!pattern_detector(node.player, node.opponent, BitBoard::patterns[0]).is_empty())
-        return (50000000 * depth);
-    score += pair_capture_detector(node.player, node.opponent).set_count() * 50;
-    score += node.player_pairs_captured * node.player_pairs_captured * 100;
-    return (score);
-}
-
-static inline int64_t   opponent_evaluation(t_node const &node, uint8_t depth) {
-    int64_t     score = 0;
-
-    if (node.opponent_pairs_captured >= 5)
-        return (50000000 * depth);
-    if (!pattern_detector(node.opponent, node.player, BitBoard::patterns[0]).is_empty())
-        return (50000000 * depth);
-    score += pair_capture_detector(node.opponent, node.player).set_count() * 50;
-    score += node.opponent_pairs_captured * node.opponent_pairs_captured * 100;
-    return (score);
+/* the evaluation of one side : a win (by capture or by alignment), otherwise its capture moves and the pairs it captured */
+static inline int64_t   side_evaluation(int pairs_captured, bool five, int captures, uint8_t depth) {
+    if (pairs_captured >= 5 || five)
+        return (WIN_SCORE * depth);
+    return (captures * 50 + pairs_captured * pairs_captured * 100);
 }
 
-int32_t AIPlayer::evaluation_function(t_node const &node, uint8_t depth) {
-    int64_t     score = 0;
+/*  evaluate the children in `moves` (used for the move ordering) by batches of BATCH boards, the
+    fives and the capture moves of all the children of a batch being detected together
+*/
+void    AIPlayer::evaluation_function(std::vector<t_move> &moves, uint8_t depth) {
+    BitBoardBatch           player;
+    BitBoardBatch           opponent;
+    uint32_t                player_five;
+    uint32_t                opponent_five;
+    std::array<int, BATCH>  player_captures;
+    std::array<int, BATCH>  opponent_captures;
+    int64_t                 score;
 
-    /* we give more weight to the player whose turn is next */
-    score += player_evaluation(node, depth) * (node.cid == 2 ? 2:1);
-    score -= opponent_evaluation(node, depth) * (node.cid == 1 ? 2:1);
-    return (score);
+    for (size_t b = 0; b < moves.size(); b += BATCH) {
+        for (size_t k = 0; k < BATCH; ++k) {
+            player.load(k, (b + k < moves.size() ? moves[b + k].node.player : BitBoard::empty));
+            opponent.load(k, (b + k < moves.size() ? moves[b + k].node.opponent : BitBoard::empty));
+        }
+        player_five = five_detector(player);
+        opponent_five = five_detector(opponent);
+        player_captures = pair_capture_detector(player, opponent).set_count();
+        opponent_captures = pair_capture_detector(opponent, player).set_count();
+        for (size_t k = 0; k < BATCH && b + k < moves.size(); ++k) {
+            t_node const &node = moves[b + k].node;
+            /* we give more weight to the player whose turn is next */
+            score = side_evaluation(node.player_pairs_captured, player_five >> k & 1, player_captures[k], depth) * (node.cid == 2 ? 2:1);
+            score -= side_evaluation(node.opponent_pairs_captured, opponent_five >> k & 1, opponent_captures[k], depth) * (node.cid == 1 ? 2:1);
+            moves[b + k].eval = score;
+        }
+    }
 }
 
 bool    AIPlayer::checkEnd(t_node const& node) {
@@ -239,6 +308,13 @@ bool    AIPlayer::checkEnd(t_node const& node) {
     return (check_end(node.opponent, node.player, node.opponent_pairs_captured, node.player_pairs_captured, node.move));
 }
 
+/*  a win weighted by its depth, whatever the rest of the evaluation (the other side scores far less than
+    half a win)
+*/
+bool    is_win_score(int score) {
+    return (score >= WIN_SCORE / 2 || score <= -WIN_SCORE / 2);
+}
+
 bool    sort_ascending(t_move const& a, t_move const& b) {
     return (a.eval < b.eval);
 }
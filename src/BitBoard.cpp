@@ -1,13 +1,51 @@
 #include "BitBoard.hpp"
+#ifdef __AVX2__
+# include <immintrin.h>
+#endif
+
+# define ROW_MASK (0xFFFFFFFFFFFFFFFF << (BITS - BOARD_SIZE))  /* the first BOARD_SIZE bits of an int64 */
+# define PADDING (NICB * BITS - STRIDE * BOARD_SIZE)             /* number of unused bits at the end of the last int64 */
+
+/*  the int64 at index i of one of the board masks (all the cells, or the cells on one of the borders),
+    computed at compile time from BOARD_SIZE
+*/
+namespace mask {
+    enum mask {
+        full,
+        border_right,
+        border_left,
+        border_top,
+        border_bottom
+    };
+};
+
+static constexpr uint64_t   mask_word(const int kind, const int i) {
+    uint64_t    res = 0;
+
+    for (int b = 0; b < BITS; ++b) {
+        const int   x = (BITS * i + b) % STRIDE;
+        const int   y = (BITS * i + b) / STRIDE;
+        if (y < BOARD_SIZE && x < BOARD_SIZE && (kind == mask::full
+            || (kind == mask::border_right && x == BOARD_SIZE - 1) || (kind == mask::border_left && x == 0)
+            || (kind == mask::border_top && y == 0) || (kind == mask::border_bottom && y == BOARD_SIZE - 1)))
+            res |= (0x8000000000000000 >> b);
+    }
+    return (res);
+}
+
+template <size_t... I>
+static constexpr BitBoard   board_mask(const int kind, std::index_sequence<I...>) {
+    return (BitBoard(std::array<uint64_t, NICB>{{ mask_word(kind, I)... }}));
+}
 
 /* assignation of static variables */
-const std::array<int16_t, DIRS>  BitBoard::shifts = {{-19, -18, 1, 20, 19, 18, -1, -20}};
-const BitBoard                BitBoard::full = (std::array<uint64_t, NICB>){{0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFF800000}};
-const BitBoard                BitBoard::empty = (std::array<uint64_t, NICB>){{0, 0, 0, 0, 0, 0}};
-const BitBoard                BitBoard::border_right = (std::array<uint64_t, NICB>){{0x200004000080, 0x10000200004000, 0x800010000200004, 0x800010000200, 0x40000800010000, 0x2000040000800000}};
-const BitBoard                BitBoard::border_left = (std::array<uint64_t, NICB>){{0x8000100002000040, 0x8000100002000, 0x400008000100002, 0x400008000100, 0x20000400008000, 0x1000020000000000}};
-const BitBoard                BitBoard::border_top = (std::array<uint64_t, NICB>){{0xFFFFE00000000000, 0, 0, 0, 0, 0}};
-const BitBoard                BitBoard::border_bottom = (std::array<uint64_t, NICB>){{0, 0, 0, 0, 0, 0x3FFFF800000}};
+const std::array<int16_t, DIRS>  BitBoard::shifts = {{-STRIDE, -(STRIDE-1), 1, STRIDE+1, STRIDE, STRIDE-1, -1, -(STRIDE+1)}};
+constexpr BitBoard            BitBoard::full = board_mask(mask::full, std::make_index_sequence<NICB>());
+constexpr BitBoard            BitBoard::empty = BitBoard();
+constexpr BitBoard            BitBoard::border_right = board_mask(mask::border_right, std::make_index_sequence<NICB>());
+constexpr BitBoard            BitBoard::border_left = board_mask(mask::border_left, std::make_index_sequence<NICB>());
+constexpr BitBoard            BitBoard::border_top = board_mask(mask::border_top, std::make_index_sequence<NICB>());
+constexpr BitBoard            BitBoard::border_bottom = board_mask(mask::border_bottom, std::make_index_sequence<NICB>());
 const std::array<t_pattern,8> BitBoard::patterns = {{
     (t_pattern){0xF8, 5, 4, 500, 5000},  //   OOOOO  :  five
     (t_pattern){0x78, 6, 4, 500, 1100},  //  -OOOO-  :  open four
@@ -22,59 +60,111 @@ std::array<int, 8>  BitBoard::p1_pattern_weights = {{0, 0, 0, 0, 0, 0, 0, 0}};
 std::array<int, 8>  BitBoard::p2_pattern_weights = {{0, 0, 0, 0, 0, 0, 0, 0}};
 
 
-/* population count of a 64-bit unsigned integer (count the number of set bits) */
-static int popcount64(uint64_t x) {
-    x = x - ((x >> 1) & 0x5555555555555555);
-    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
-    return (((x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F) * 0x0101010101010101) >> 56;
-}
-
-BitBoard::BitBoard(void) {
-    this->zeros();
-}
-
-BitBoard::BitBoard(std::array<uint64_t, NICB> values) {
-    this->values = values;
-}
-
-BitBoard::BitBoard(BitBoard const &src) {
-    *this = src;
-}
-
-BitBoard::~BitBoard(void) {
-}
-
-BitBoard	&BitBoard::operator=(BitBoard const &rhs) {
-    this->values = rhs.values;
-    return (*this);
-}
+#ifdef __AVX2__
+/*  AVX2 backend : the NICB int64 of the board are held in 256-bit registers, `lo` holding values[0..3].
+    On a 19x19 board `hi` holds values[4..5] followed by two padding lanes (kept to zero on load, and
+    ignored on store), a 15x15 board fits in `lo` alone. The memory layout stays the same (NICB int64),
+    so nothing changes for the rest of the code.
+*/
+typedef struct  s_simd_board {
+    __m256i     lo; /* values[0..3] */
+# if NICB > 4
+    __m256i     hi; /* values[4..NICB-1] followed by padding lanes */
+# endif
+}               t_simd_board;
+
+# if NICB > 4
+static inline __m256i       simd_hi_mask(void) {
+    return (_mm256_cmpgt_epi64(_mm256_set1_epi64x(NICB - 4), _mm256_setr_epi64x(0, 1, 2, 3)));
+}
+# endif
+
+static inline t_simd_board  simd_load(std::array<uint64_t, NICB> const &values) {
+    return ((t_simd_board){
+        _mm256_loadu_si256((__m256i const *)&values[0]),
+# if NICB > 4
+        _mm256_maskload_epi64((long long const *)&values[4], simd_hi_mask())
+# endif
+    });
+}
+
+static inline void          simd_store(std::array<uint64_t, NICB> &values, t_simd_board const &b) {
+    _mm256_storeu_si256((__m256i *)&values[0], b.lo);
+# if NICB > 4
+    _mm256_maskstore_epi64((long long *)&values[4], simd_hi_mask(), b.hi);
+# endif
+}
+
+/* move every int64 one lane up (values[i] = values[i-1]), a zero enters in values[0] */
+static inline t_simd_board  simd_lane_up(t_simd_board const &b) {
+    const __m256i   zero = _mm256_setzero_si256();
+    return ((t_simd_board){
+        _mm256_blend_epi32(_mm256_permute4x64_epi64(b.lo, _MM_SHUFFLE(2,1,0,0)), zero, 0x03),
+# if NICB > 4
+        _mm256_blend_epi32(_mm256_permute4x64_epi64(b.hi, _MM_SHUFFLE(2,1,0,0)), _mm256_permute4x64_epi64(b.lo, _MM_SHUFFLE(3,3,3,3)), 0x03)
+# endif
+    });
+}
+
+/* move every int64 one lane down (values[i] = values[i+1]), a zero (or the zeroed padding) enters in values[NICB-1] */
+static inline t_simd_board  simd_lane_down(t_simd_board const &b) {
+    const __m256i   zero = _mm256_setzero_si256();
+    return ((t_simd_board){
+# if NICB > 4
+        _mm256_blend_epi32(_mm256_permute4x64_epi64(b.lo, _MM_SHUFFLE(0,3,2,1)), _mm256_permute4x64_epi64(b.hi, _MM_SHUFFLE(0,0,0,0)), 0xC0),
+        _mm256_blend_epi32(_mm256_permute4x64_epi64(b.hi, _MM_SHUFFLE(0,3,2,1)), zero, 0xC0)
+# else
+        _mm256_blend_epi32(_mm256_permute4x64_epi64(b.lo, _MM_SHUFFLE(0,3,2,1)), zero, 0xC0)
+# endif
+    });
+}
+
+/* shift every int64 of `b` by `a` bits, receiving the bits of `c` (the neighbour lanes) shifted the other way by `r` */
+static inline t_simd_board  simd_merge_right(t_simd_board const &b, t_simd_board const &c, __m128i const &a, __m128i const &r) {
+    return ((t_simd_board){
+        _mm256_or_si256(_mm256_srl_epi64(b.lo, a), _mm256_sll_epi64(c.lo, r)),
+# if NICB > 4
+        _mm256_or_si256(_mm256_srl_epi64(b.hi, a), _mm256_sll_epi64(c.hi, r))
+# endif
+    });
+}
+
+static inline t_simd_board  simd_merge_left(t_simd_board const &b, t_simd_board const &c, __m128i const &a, __m128i const &r) {
+    return ((t_simd_board){
+        _mm256_or_si256(_mm256_sll_epi64(b.lo, a), _mm256_srl_epi64(c.lo, r)),
+# if NICB > 4
+        _mm256_or_si256(_mm256_sll_epi64(b.hi, a), _mm256_srl_epi64(c.hi, r))
+# endif
+    });
+}
+
+static inline bool          simd_is_zero(t_simd_board const &b) {
+# if NICB > 4
+    return (_mm256_testz_si256(_mm256_or_si256(b.lo, b.hi), _mm256_or_si256(b.lo, b.hi)));
+# else
+    return (_mm256_testz_si256(b.lo, b.lo));
+# endif
+}
+#endif
 
 BitBoard	&BitBoard::operator=(uint64_t const &val) {
-    this->values[4] = (val >> 41);
-    this->values[5] = (val << 23);
+    this->values[NICB-2] = (val >> (BITS - PADDING));
+    this->values[NICB-1] = (val << PADDING);
     return (*this);
 }
 
 /*
 ** Helper functions
 */
-/*  return a given row of the bitboard, the lookup table are the binary masks for fast
-    access to the values. there are 24 of them because 5 rows out of the 19 are splitted
-    in two uint64_t (see BitBoard.hpp to see where the splits are).
+/*  return a given row of the bitboard (in the first BOARD_SIZE bits), some of the rows are
+    splitted in two uint64_t (see BitBoard.hpp to see where the splits are).
 */
 uint64_t    BitBoard::row(uint8_t i) const {
-    static const uint64_t masks[24] = {
-        0xFFFFE00000000000,     0x1FFFFC000000,         0x3FFFF80,              0x7F,
-        0xFFFFE00000000,           0x1FFFFC000,            0x3FFF, 0x7FFFF0000000000,
-        0xFFFFE00000,                 0x1FFFFC,               0x3,    0x7FFFF0000000,
-        0xFFFFE00,                       0x1FF,  0x3FFFF800000000,       0x7FFFF0000,
-        0xFFFF,             0x1FFFFC0000000000,     0x3FFFF800000,0xFFF0000000000000,
-        0xF800000000000000, 0xFFFF800000000000,0xFFC0000000000000, 0xE000000000000000 };
-    uint64_t    n = (i * 19) / BITS;
-    uint64_t    s = (i * 19) % BITS;
-    if (i==3||i==6||i==10||i==13||i==16)
-        return (((this->values[n] & masks[i]) << s) | ((this->values[n+1] & masks[19+n]) >> (BITS-s)) );
-    return ((this->values[n] & masks[i]) << s);
+    const uint64_t  n = (i * STRIDE) / BITS;
+    const uint64_t  s = (i * STRIDE) % BITS;
+    if (s > BITS - BOARD_SIZE)
+        return (((this->values[n] << s) | (this->values[n+1] >> (BITS-s))) & ROW_MASK);
+    return ((this->values[n] << s) & ROW_MASK);
 }
 
 void    BitBoard::zeros(void) {
@@ -82,85 +172,60 @@ void    BitBoard::zeros(void) {
         this->values[i] = 0;
 }
 
-/*  will broadcast the given row (only the first 19 bits) to all rows,
-    the pattern must be encoded in the first 19 bits
+/*  will broadcast the given row (only the first BOARD_SIZE bits) to all rows,
+    the pattern must be encoded in the first BOARD_SIZE bits
 */
 void    BitBoard::broadcast_row(uint64_t row) {
-    uint16_t    offset = 19;
-    int32_t     shift = 0;
+    BitBoard    first;
 
-    row >>= BITS-19;
+    first.values[0] = row & ROW_MASK;
     this->zeros();
-    for (int i = 0; i < NICB; ++i) {
-        shift = 1;
-        for (int j = 0; shift > 0; ++j) {
-            shift = BITS - offset - (19 * j);
-            this->values[i] |= (shift > 0 ? row << shift : row >> -shift);
-        }
-        offset = -shift;
-    }
+    for (int i = 0; i < BOARD_SIZE; ++i)
+        *this |= first >> (STRIDE * i);
 }
 
 void    BitBoard::write(const uint64_t x, const uint64_t y) {
-    const uint64_t    n = (19 * y + x);
+    const uint64_t    n = (STRIDE * y + x);
     this->values[n >> 6] |= (0x8000000000000000 >> (n & 0x3F));
 }
 
 void    BitBoard::remove(const uint64_t x, const uint64_t y) {
-    const uint64_t    n = (19 * y + x);
+    const uint64_t    n = (STRIDE * y + x);
     this->values[n >> 6] &= ~(0x8000000000000000 >> (n & 0x3F));
 }
 
 void    BitBoard::write(const uint64_t i) {
-    this->values[i >> 6] |= (0x8000000000000000 >> (i & 0x3F));
+    const uint64_t    n = BitBoard::cell_to_bit(i);
+    this->values[n >> 6] |= (0x8000000000000000 >> (n & 0x3F));
 }
 
 void    BitBoard::remove(const uint64_t i) {
-    this->values[i >> 6] &= ~(0x8000000000000000 >> (i & 0x3F));
-}
-
-int    BitBoard::set_count(void) const {
-    int         res = 0;
-    for (int i = NICB; i--; )
-        res += popcount64(this->values[i]);
-    return (res);
-}
-
-bool    BitBoard::check_bit(const uint64_t i) const {
-    return ((this->values[i >> 6] & (0x8000000000000000 >> (i & 0x3F))) == 0 ? false : true);
-}
-
-bool    BitBoard::check_bit(const uint64_t x, const uint64_t y) const {
-    const uint16_t    n = (19 * y + x);
-    return ((this->values[n >> 6] & (0x8000000000000000 >> (n & 0x3F))) == 0 ? false : true);
+    const uint64_t    n = BitBoard::cell_to_bit(i);
+    this->values[n >> 6] &= ~(0x8000000000000000 >> (n & 0x3F));
 }
 
 bool    BitBoard::is_empty(void) const {
+#ifdef __AVX2__
+    return (simd_is_zero(simd_load(this->values)));
+#else
     for (int i = 0; i < NICB; ++i)
         if (this->values[i])
             return (false);
     return (true);
+#endif
 }
 
 int     BitBoard::leftmost_bit(void) const {
     for (int i = 0; i < NICB; ++i)
-        if (this->values[i]) {
-            uint64_t x = this->values[i];
-            x |= (x >> 1);
-            x |= (x >> 2);
-            x |= (x >> 4);
-            x |= (x >> 8);
-            x |= (x >> 16);
-            x |= (x >> 32);
-            return (BITS-popcount64(x)+(i<<6));
-        }
+        if (this->values[i])
+            return (BitBoard::bit_to_cell((i << 6) + __builtin_clzll(this->values[i])));
     return (-1);
 }
 
 int     BitBoard::rightmost_bit(void) const {
     for (int i = NICB; i--;)
         if (this->values[i])
-            return (((i+1) << 6) - popcount64((this->values[i] & -this->values[i]) - 1)-1);
+            return (BitBoard::bit_to_cell((i << 6) + BITS - 1 - __builtin_ctzll(this->values[i])));
     return (-1);
 }
 
@@ -178,27 +243,19 @@ BitBoard    BitBoard::shifted_inv(const uint8_t dir, const uint8_t n) const {
     return (BitBoard::shifted(dir < 4 ? dir + 4 : dir - 4, n));
 }
 
-/* return the dilated board taking into account the board boundaries */
+/* return the dilated board taking into account the board boundaries (the guard bits reached are cleared) */
 BitBoard    BitBoard::dilated(void) const {
 	BitBoard	res = *this;
-    for (int i = direction::north_east; i < direction::south; ++i)
-        res |= this->shifted(i) & ~BitBoard::border_left;
-    for (int i = direction::south_west; i < 8; ++i)
-        res |= this->shifted(i) & ~BitBoard::border_right;
-    res |= this->shifted(direction::north);
-    res |= this->shifted(direction::south);
-    return (res);
+    for (int i = direction::north; i < DIRS; ++i)
+        res |= this->shifted(i);
+    return (res & BitBoard::full);
 }
 
-/* return the eroded board taking into account the board boundaries */
+/* return the eroded board taking into account the board boundaries (the cells beyond are read from guard bits) */
 BitBoard    BitBoard::eroded(void) const {
 	BitBoard	res = *this;
-    for (int i = direction::north_east; i < direction::south; ++i)
-        res &= this->shifted(i) & ~BitBoard::border_left;
-    for (int i = direction::south_west; i < 8; ++i)
-        res &= this->shifted(i) & ~BitBoard::border_right;
-    res &= this->shifted(direction::north);
-    res &= this->shifted(direction::south);
+    for (int i = direction::north; i < DIRS; ++i)
+        res &= this->shifted(i);
     return (res);
 }
 
@@ -209,45 +266,58 @@ BitBoard    BitBoard::rotated_45(void) {
     uint64_t    v = 1;
 
     v <<= BITS - 1;
-    for (int j = 0; j < 19; j++) {
+    for (int j = 0; j < BOARD_SIZE; j++) {
         mask.broadcast_row(v);
-        res |= ((*this >> (19 * j) | *this << (19 * (19 - j)))) & mask;
+        res |= ((*this >> (STRIDE * j) | *this << (STRIDE * (BOARD_SIZE - j)))) & mask;
         v >>= 1;
     }
     return (res);
 }
 
+#ifdef __AVX2__
 /*
-** Arithmetic operator overload
+** Shift operator overload
 */
-BitBoard	BitBoard::operator|(const BitBoard &rhs) const {
-	BitBoard	res;
-    for (int i = 0; i < NICB; ++i)
-        res.values[i] = this->values[i] | rhs.values[i];
-	return (res);
-}
-
-BitBoard	BitBoard::operator&(const BitBoard &rhs) const {
-	BitBoard	res;
-    for (int i = 0; i < NICB; ++i)
-        res.values[i] = this->values[i] & rhs.values[i];
-	return (res);
-}
-
-BitBoard    BitBoard::operator^(BitBoard const &rhs) const {
+/*  cross-word shifts : the board is first moved by whole int64 lanes (shift / 64), then each lane is
+    shifted by the remaining bits and receives the bits overflowing from its neighbour lane. A shift
+    count of 64 gives 0 with AVX2, so there's no special case when the shift is a multiple of 64.
+*/
+BitBoard    BitBoard::operator>>(const int32_t shift) const {
     BitBoard	res;
-    for (int i = 0; i < NICB; ++i)
-        res.values[i] = this->values[i] ^ rhs.values[i];
+    if (shift <= 0)
+        return (*this);
+    if (shift >= BITS * NICB)
+        return (res);
+    t_simd_board    b = simd_load(this->values);
+    for (int i = shift >> 6; i > 0; --i)
+        b = simd_lane_up(b);
+    const t_simd_board  c = simd_lane_up(b);
+    const __m128i       a = _mm_cvtsi32_si128(shift & 0x3F);
+    const __m128i       r = _mm_cvtsi32_si128(BITS - (shift & 0x3F));
+    simd_store(res.values, simd_merge_right(b, c, a, r));
     return (res);
 }
 
-BitBoard	BitBoard::operator~(void) const {
-	BitBoard	res;
-    for (int i = 0; i < NICB; ++i)
-        res.values[i] = ~this->values[i];
-	return (res);
+BitBoard    BitBoard::operator<<(const int32_t shift) const {
+    BitBoard	res;
+    if (shift <= 0)
+        return (*this);
+    if (shift >= BITS * NICB)
+        return (res);
+    t_simd_board    b = simd_load(this->values);
+    for (int i = shift >> 6; i > 0; --i)
+        b = simd_lane_down(b);
+    const t_simd_board  c = simd_lane_down(b);
+    const __m128i       a = _mm_cvtsi32_si128(shift & 0x3F);
+    const __m128i       r = _mm_cvtsi32_si128(BITS - (shift & 0x3F));
+    simd_store(res.values, simd_merge_left(b, c, a, r));
+    return (res);
 }
 
+#else
+/*
+** Shift operator overload (scalar fallback)
+*/
 BitBoard    BitBoard::operator>>(const int32_t shift) const {
     BitBoard	res;
     if (shift <= 0)
@@ -261,7 +331,7 @@ BitBoard    BitBoard::operator>>(const int32_t shift) const {
         const uint16_t    a = shift & 0x3F;
         for (int i = NICB-1; i > n; i--) {
             if (a == 0)
-                res.values[i] = (this->values[i-n] << (BITS - a));
+                res.values[i] = this->values[i-n];
             else
                 res.values[i] = (this->values[i-n] >> a) | (this->values[i-(n+1)] << (BITS - a));
         }
@@ -275,7 +345,7 @@ BitBoard    BitBoard::operator<<(const int32_t shift) const {
     if (shift <= 0)
         return (*this);
     else if (shift < BITS) {
-        for (int i = 0; i < NICB; ++i)
+        for (int i = 0; i < NICB-1; ++i)
             res.values[i] = (this->values[i] << shift) | (this->values[i+1] >> (BITS - shift));
         res.values[NICB-1] = (this->values[NICB-1] << shift);
     } else {
@@ -284,7 +354,7 @@ BitBoard    BitBoard::operator<<(const int32_t shift) const {
         const uint16_t    p = NICB - (n + 1);
         for (int i = 0; i < p; ++i) {
             if (a == 0)
-                res.values[i] = (this->values[i+n] >> (BITS - a));
+                res.values[i] = this->values[i+n];
             else
                 res.values[i] = (this->values[i+n] << a) | (this->values[i+n+1] >> (BITS - a));
         }
@@ -292,28 +362,11 @@ BitBoard    BitBoard::operator<<(const int32_t shift) const {
     }
 	return (res);
 }
+#endif
 
 /*
 ** Assignation operator overload
 */
-BitBoard    &BitBoard::operator|=(BitBoard const &rhs) {
-    for (int i = 0; i < NICB; ++i)
-        this->values[i] = (this->values[i] | rhs.values[i]);
-    return (*this);
-}
-
-BitBoard    &BitBoard::operator&=(BitBoard const &rhs) {
-    for (int i = 0; i < NICB; ++i)
-        this->values[i] = (this->values[i] & rhs.values[i]);
-    return (*this);
-}
-
-BitBoard    &BitBoard::operator^=(BitBoard const &rhs) {
-    for (int i = 0; i < NICB; ++i)
-        this->values[i] = (this->values[i] ^ rhs.values[i]);
-    return (*this);
-}
-
 BitBoard    &BitBoard::operator<<=(const int32_t shift) {
     *this = (*this << shift);
     return (*this);
@@ -324,28 +377,15 @@ BitBoard    &BitBoard::operator>>=(const int32_t shift) {
     return (*this);
 }
 
-/*
-** Member access operator overload
-*/
-uint64_t    BitBoard::operator[](const int i) const {
-    return (this->values[i >> 6] & (0x8000000000000000 >> (i & 0x3F)));
-}
-
 /*
 ** Comparison operator overload
 */
 bool        BitBoard::operator==(BitBoard const &rhs) const {
-    for (int i = 0; i < NICB; ++i)
-        if (this->values[i] != rhs.values[i])
-            return (false);
-    return (true);
+    return ((*this ^ rhs).is_empty());
 }
 
 bool        BitBoard::operator!=(BitBoard const &rhs) const {
-    for (int i = 0; i < NICB; ++i)
-        if (this->values[i] != rhs.values[i])
-            return (true);
-    return (false);
+    return (!(*this == rhs));
 }
 
 /*
@@ -355,15 +395,15 @@ bool        BitBoard::operator!=(BitBoard const &rhs) const {
 BitBoard    get_threat_moves(BitBoard const &p1, BitBoard const &p2, int p2_pairs_captured) {
     BitBoard    res;
     res |= win_by_capture_detector(p2, p1, p2_pairs_captured);
-    res |= pattern_detector_highlight_open(p2, p1, { 0x70, 5, 4, 0, 0 }); // -OOO-
-    res |= pattern_detector_highlight_open(p2, p1, { 0x68, 6, 8, 0, 0 }); // -OO-O-
-    res |= future_pattern_detector(p2, p1, { 0xF8, 5, 8, 0, 0 }); // future pattern detection on OOOOO
+    res |= pattern_detector_highlight_open<0x70, 5, 4>(p2, p1); // -OOO-
+    res |= pattern_detector_highlight_open<0x68, 6, 8>(p2, p1); // -OO-O-
+    res |= future_pattern_detector<0xF8, 5, 8>(p2, p1); // future pattern detection on OOOOO
     return (res & ~p1 & ~p2);
 }
 
 /* return the moves that instant win (no possible counter by opponent) */
 BitBoard    get_winning_moves(BitBoard const &p1, BitBoard const &p2, int p1_pairs_captured, int p2_pairs_captured) {
-    BitBoard    res = future_pattern_detector(p1, p2, { 0xF8, 5, 8, 0, 0 }); // OOOOO
+    BitBoard    res = future_pattern_detector<0xF8, 5, 8>(p1, p2); // OOOOO
     /* if there is no possibility of breaking the alignment and no winning pair capture either */
     res = highlight_five_aligned((p1 | res) ^ pair_capture_detector_highlight(p2, (p1 | res)));
     if (!res.is_empty() && win_by_capture_detector(p2, p1, p2_pairs_captured).is_empty())
@@ -374,12 +414,11 @@ BitBoard    get_winning_moves(BitBoard const &p1, BitBoard const &p2, int p1_pai
 
 /* detect a sub-pattern in a single direction */
 static BitBoard single_direction_pattern_detector(BitBoard const &p1, BitBoard const &p2, uint8_t const &pattern, uint8_t const &length, uint8_t const &s, uint8_t const &type, uint8_t const &dir) {
-    const BitBoard  open_cells = (~p1 & ~p2);
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
     BitBoard        res;
 
     res = (type == 0x80 ? p2 : BitBoard::full);
     for (int n = 0; n < length && !res.is_empty(); ++n) {
-        res = (dir > 0 && dir < 4 ? res & ~BitBoard::border_right : (dir > 4 && dir < 8 ? res & ~BitBoard::border_left : res));
         res = res.shifted(dir) & ((pattern << n & 0x80) == 0x80 ? p1 : open_cells);
     }
     return (res.shifted_inv(dir, s) & open_cells);
@@ -458,15 +497,108 @@ BitBoard    three_four_detector(BitBoard const &p1, BitBoard const &p2) {
     return (res & ~p1 & ~p2);
 }
 
+/*  the boards of a player, of the other player and of the open cells seen from an axis : at index
+    MAX_OFFSET + k is the board of the cells t for which t + k * dir is in the board (dir being the
+    direction of the axis, north to south-east). They're computed with single steps masked by the
+    full board, so the cells can't wrap around the board.
+*/
+# define MAX_OFFSET 6
+
+typedef struct  s_axis_boards {
+    BitBoard    p[2][2 * MAX_OFFSET + 1];
+    BitBoard    open[2 * MAX_OFFSET + 1];
+}               t_axis_boards;
+
+static void     axis_boards(t_axis_boards &axis, BitBoard const &p1, BitBoard const &p2, BitBoard const &open_cells, uint8_t const &dir) {
+    axis.p[0][MAX_OFFSET] = p1;
+    axis.p[1][MAX_OFFSET] = p2;
+    axis.open[MAX_OFFSET] = open_cells;
+    for (int k = 1; k <= MAX_OFFSET; ++k) {
+        axis.p[0][MAX_OFFSET - k] = axis.p[0][MAX_OFFSET - k + 1].shifted(dir) & BitBoard::full;
+        axis.p[1][MAX_OFFSET - k] = axis.p[1][MAX_OFFSET - k + 1].shifted(dir) & BitBoard::full;
+        axis.open[MAX_OFFSET - k] = axis.open[MAX_OFFSET - k + 1].shifted(dir) & BitBoard::full;
+        axis.p[0][MAX_OFFSET + k] = axis.p[0][MAX_OFFSET + k - 1].shifted_inv(dir) & BitBoard::full;
+        axis.p[1][MAX_OFFSET + k] = axis.p[1][MAX_OFFSET + k - 1].shifted_inv(dir) & BitBoard::full;
+        axis.open[MAX_OFFSET + k] = axis.open[MAX_OFFSET + k - 1].shifted_inv(dir) & BitBoard::full;
+    }
+}
+
+/*  return the open cells where placing a stone of player `pid` completes the pattern (the same cells as
+    single_direction_pattern_detector with every sub-pattern missing one stone), the cell before
+    the pattern having to be on the board
+*/
+static BitBoard axis_future_pattern(t_axis_boards const &axis, int pid, uint8_t const &pattern, uint8_t const &length) {
+    BitBoard    res;
+    BitBoard    tmp;
+
+    for (int j = 0; j < length; ++j) { /* j is the index of the missing stone */
+        if (!(pattern << j & 0x80))
+            continue;
+        tmp = axis.open[MAX_OFFSET] & (axis.p[0][MAX_OFFSET - 1 - j] | axis.p[1][MAX_OFFSET - 1 - j] | axis.open[MAX_OFFSET - 1 - j]);
+        for (int n = 0; n < length && !tmp.is_empty(); ++n)
+            if (n != j)
+                tmp &= ((pattern << n & 0x80) ? axis.p[pid][MAX_OFFSET + n - j] : axis.open[MAX_OFFSET + n - j]);
+        res |= tmp;
+    }
+    return (res);
+}
+
+/* return the open cells capturing a pair of the other player in both directions of the axis (|OO- and -OO|) */
+static BitBoard axis_captures(t_axis_boards const &axis, int pid) {
+    return ((axis.open[MAX_OFFSET] & axis.p[!pid][MAX_OFFSET - 1] & axis.p[!pid][MAX_OFFSET - 2] & axis.p[pid][MAX_OFFSET - 3])
+        | (axis.open[MAX_OFFSET] & axis.p[!pid][MAX_OFFSET + 1] & axis.p[!pid][MAX_OFFSET + 2] & axis.p[pid][MAX_OFFSET + 3]));
+}
+
+/* return the stones of player `pid` in a pair that the other player can capture in both directions of the axis */
+static BitBoard axis_threatened(t_axis_boards const &axis, int pid) {
+    const BitBoard  pairs = axis.p[pid][MAX_OFFSET];
+    return ((pairs & axis.open[MAX_OFFSET + 1] & axis.p[pid][MAX_OFFSET - 1] & axis.p[!pid][MAX_OFFSET - 2])
+        | (pairs & axis.open[MAX_OFFSET + 2] & axis.p[pid][MAX_OFFSET + 1] & axis.p[!pid][MAX_OFFSET - 1])
+        | (pairs & axis.open[MAX_OFFSET - 1] & axis.p[pid][MAX_OFFSET + 1] & axis.p[!pid][MAX_OFFSET + 2])
+        | (pairs & axis.open[MAX_OFFSET - 2] & axis.p[pid][MAX_OFFSET - 1] & axis.p[!pid][MAX_OFFSET + 1]));
+}
+
+/*  compute the three_four, four_four, forbidden, captures and threatened boards of both players at once.
+    For each of the 4 axes, the boards are shifted step by step only once (see t_axis_boards), then every
+    pattern is an intersection of these shifted boards instead of its own chain of shifts.
+*/
+t_pattern_boards    fused_pattern_detector(BitBoard const &p1, BitBoard const &p2) {
+    const uint8_t       threes[3] = { 0x58, 0x68, 0x70 };               // -O-OO-, -OO-O-, -OOO-
+    const uint8_t       threes_lengths[3] = { 6, 6, 5 };
+    const uint8_t       fours[4] = { 0x78, 0xF0, 0xE8, 0xB8 };          // -OOOO~, ~OOOO-, ~OOO-O~, ~O-OOO~
+    const BitBoard      open_cells = (~p1 & ~p2 & BitBoard::full);
+    t_pattern_boards    res;
+    t_axis_boards       axis;
+    BitBoard            three[2][4];
+    BitBoard            four[2][4];
+
+    for (int d = direction::north; d < 4; ++d) {
+        axis_boards(axis, p1, p2, open_cells, d);
+        for (int pid = 0; pid < 2; ++pid) {
+            for (int p = 0; p < 3; ++p)
+                three[pid][d] |= axis_future_pattern(axis, pid, threes[p], threes_lengths[p]);
+            for (int p = 0; p < 4; ++p)
+                four[pid][d] |= axis_future_pattern(axis, pid, fours[p], 5);
+            res.captures[pid] |= axis_captures(axis, pid);
+            res.threatened[pid] |= axis_threatened(axis, pid);
+            for (int n = d-1; n >= 0; --n) {
+                res.forbidden[pid] |= three[pid][d] & three[pid][n];
+                res.four_four[pid] |= four[pid][d] & four[pid][n];
+                res.three_four[pid] |= three[pid][d] & four[pid][n];
+            }
+        }
+    }
+    return (res);
+}
+
 static BitBoard sub_pattern_detector(BitBoard const &p1, BitBoard const &p2, t_pattern const &pattern, uint8_t const &s, uint8_t const &type) {
-    const BitBoard  open_cells = (~p1 & ~p2);
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
     BitBoard        res;
     BitBoard        tmp;
 
     for (int d = direction::north; d < pattern.dirs; ++d) {
         tmp = (type == 0x80 ? p2 : BitBoard::full);
         for (int n = 0; n < pattern.size && !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp = tmp.shifted(d) & ((pattern.repr << n & 0x80) == 0x80 ? p1 : open_cells);
         }
         res |= tmp.shifted_inv(d, s);
@@ -497,14 +629,13 @@ BitBoard        pattern_detector(BitBoard const &p1, BitBoard const &p2, t_patte
 
 BitBoard    pattern_detector_highlight_open(BitBoard const &p1, BitBoard const &p2, t_pattern const &pattern) {
     const uint8_t   type = (pattern.repr & 0x80) | (0x1 << (8-pattern.size) & pattern.repr);
-    const BitBoard  open_cells = (~p1 & ~p2);
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
     BitBoard        res;
     BitBoard        tmp;
 
     for (int d = direction::north; d < pattern.dirs; ++d) {
         tmp = (type == 0x80 ? p2 : BitBoard::full);
         for (int n = 0; n < pattern.size && !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp = tmp.shifted(d) & ((pattern.repr << n & 0x80) == 0x80 ? p1 : open_cells);
         }
         if (!tmp.is_empty()) {
@@ -522,7 +653,6 @@ bool        detect_five_aligned(BitBoard const &bitboard) {
     for (int d = direction::north; d < DIRS; ++d) {
         tmp = bitboard;
         for (int n = 1; !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp &= tmp.shifted(d);
             if (n >= 5)
                 return (true);
@@ -538,7 +668,6 @@ BitBoard    highlight_five_aligned(BitBoard const &bitboard) {
     for (int d = direction::north; d < 4; ++d) {
         tmp = bitboard;
         for (int n = 0; n < 4 && !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp = tmp.shifted(d) & bitboard;
         }
         for (int i = 0; i < 5 && !tmp.is_empty(); ++i)
@@ -550,14 +679,13 @@ BitBoard    highlight_five_aligned(BitBoard const &bitboard) {
 /*  detect a pair and return the positions on the bitboard where it leads to capture
 */
 BitBoard    pair_capture_detector(BitBoard const &p1, BitBoard const &p2) {
-    const BitBoard  open_cells = (~p1 & ~p2);
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
     BitBoard        res;
     BitBoard        tmp;
 
     for (int d = direction::north; d < 8; ++d) {
         tmp = p1;
         for (int n = 0; n < 3 && !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp = tmp.shifted(d) & ((0xC0 << n & 0x80) == 0x80 ? p2 : open_cells);
         }
         res |= tmp;
@@ -566,14 +694,13 @@ BitBoard    pair_capture_detector(BitBoard const &p1, BitBoard const &p2) {
 }
 
 BitBoard    pair_capture_detector_highlight(BitBoard const &p1, BitBoard const &p2) {
-    const BitBoard  open_cells = (~p1 & ~p2);
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
     BitBoard        res;
     BitBoard        tmp;
 
     for (int d = direction::north; d < 8; ++d) {
         tmp = p1;
         for (int n = 0; n < 3 && !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp = tmp.shifted(d) & ((0xC0 << n & 0x80) == 0x80 ? p2 : open_cells);
         }
         if (!tmp.is_empty())
@@ -595,29 +722,44 @@ BitBoard    pair_capture_breaking_five_detector(BitBoard const &p1, BitBoard con
     return (res);
 }
 
-BitBoard    win_by_capture_detector(BitBoard const &p1, BitBoard const &p2, int p1_pairs_captured) { // TODO : optimization
-    BitBoard    captures = pair_capture_detector(p1, p2);
-    BitBoard    res;
-    if (!captures.is_empty()) {
-        for (int i = 0; i < 361; ++i) {
-            if (captures.check_bit(i)) {
-                BitBoard tmp = p1;
-                tmp.write(i);
-                tmp = highlight_captured_stones(tmp, p2, i);
-                if (p1_pairs_captured + (tmp.set_count() / 2) >= 5) {
-                    tmp.zeros();
-                    tmp.write(i);
-                    res |= tmp;
-                }
-            }
+/*  the number of pairs captured by each open cell is counted on 4 bit-sliced boards (c[0] holding the
+    bit 0 of the count of every cell, ...), adding the capture board of each direction with a ripple carry.
+    The cells reaching the number of pairs needed are then found by comparing the 4 boards to that number,
+    from the highest bit to the lowest.
+*/
+BitBoard    win_by_capture_detector(BitBoard const &p1, BitBoard const &p2, int p1_pairs_captured) {
+    const BitBoard  open_cells = (~p1 & ~p2 & BitBoard::full);
+    const int       needed = (5 - p1_pairs_captured < 1 ? 1 : 5 - p1_pairs_captured);
+    BitBoard        c[4];
+    BitBoard        carry;
+    BitBoard        tmp;
+    BitBoard        greater;
+    BitBoard        equal = BitBoard::full;
+
+    for (int d = direction::north; d < 8; ++d) {
+        tmp = p1;
+        for (int n = 0; n < 3 && !tmp.is_empty(); ++n)
+            tmp = tmp.shifted(d) & ((0xC0 << n & 0x80) == 0x80 ? p2 : open_cells);
+        for (int b = 0; b < 4 && !tmp.is_empty(); ++b) {
+            carry = c[b] & tmp;
+            c[b] ^= tmp;
+            tmp = carry;
         }
     }
-    return (res);
+    for (int b = 3; b >= 0; --b) {
+        if (needed >> b & 1)
+            equal &= c[b];
+        else {
+            greater |= equal & c[b];
+            equal &= ~c[b];
+        }
+    }
+    return (greater | equal);
 }
 
 /* return the positions of moves leading to unbreakable five */
 BitBoard    win_by_alignment_detector(BitBoard const &p1, BitBoard const &p2, BitBoard const &p1_forbidden, int p2_pairs_captured) {
-    BitBoard    res = (p1 | future_pattern_detector(p1, p2, { 0xF8, 5, 8, 0, 0 })) & ~p1_forbidden;
+    BitBoard    res = (p1 | future_pattern_detector<0xF8, 5, 8>(p1, p2)) & ~p1_forbidden;
     res = highlight_five_aligned(res ^ pair_capture_detector_highlight(p2, res)) & ~p1 & ~p2;
     if (!res.is_empty() && win_by_capture_detector(p2, p1, p2_pairs_captured).is_empty())
         return (res);
@@ -635,7 +777,6 @@ BitBoard    highlight_captured_stones(BitBoard const &p1, BitBoard const &p2, in
         tmp.write(move);
         tmp &= p1;
         for (int n = 0; n < 3 && !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp = tmp.shifted(d) & ((0xC0 << n & 0x80) == 0x80 ? p2 : p1);
         }
         if (!tmp.is_empty())
@@ -652,16 +793,16 @@ std::ostream	&operator<<(std::ostream &os, BitBoard const &bitboard) {
     for (int i = 0; i < NICB; ++i)
         tmp += std::bitset<64>(bitboard.values[i]).to_string();
 
-    for (int i = 0; i < 19; ++i) {
-        sub = tmp.substr(i*19, 19);
-        for (int j = 0; j < 19; ++j)
-            ss << (((i*19)+j)%BITS!=0?" ":"/") << (sub[j]=='0'?"◦":"◉");
+    for (int i = 0; i < BOARD_SIZE; ++i) {
+        sub = tmp.substr(i*STRIDE, BOARD_SIZE);
+        for (int j = 0; j < BOARD_SIZE; ++j)
+            ss << (((i*STRIDE)+j)%BITS!=0?" ":"/") << (sub[j]=='0'?"◦":"◉");
         ss << std::endl;
     }
     /* show the extra bits */
-    // sub = tmp.substr(19*19, 23);
-    // for (uint32_t j = 0; j < 21; j++)
-    //     ss << (((19*19)+j)%BITS!=0?" ":"/") << (sub[j]=='0'?"◦":"◉");
+    // sub = tmp.substr(STRIDE*BOARD_SIZE, PADDING);
+    // for (uint32_t j = 0; j < PADDING; j++)
+    //     ss << (((STRIDE*BOARD_SIZE)+j)%BITS!=0?" ":"/") << (sub[j]=='0'?"◦":"◉");
     // os << ss.str()  << std::endl;
     os << ss.str();
 	return (os);
@@ -0,0 +1,139 @@
+#include "BitBoardBatch.hpp"
+
+BitBoardBatch::BitBoardBatch(void) {
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            this->words[i][k] = 0;
+}
+
+/* broadcast the board to every lane */
+BitBoardBatch::BitBoardBatch(BitBoard const &board) {
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            this->words[i][k] = board.word(i);
+}
+
+void            BitBoardBatch::load(const int k, BitBoard const &board) {
+    for (int i = 0; i < NICB; ++i)
+        this->words[i][k] = board.word(i);
+}
+
+BitBoard        BitBoardBatch::board(const int k) const {
+    std::array<uint64_t, NICB>  values;
+
+    for (int i = 0; i < NICB; ++i)
+        values[i] = this->words[i][k];
+    return (BitBoard(values));
+}
+
+uint32_t        BitBoardBatch::non_empty(void) const {
+    uint64_t    any[BATCH] = {0};
+    uint32_t    res = 0;
+
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            any[k] |= this->words[i][k];
+    for (int k = 0; k < BATCH; ++k)
+        res |= (any[k] != 0) << k;
+    return (res);
+}
+
+std::array<int, BATCH>  BitBoardBatch::set_count(void) const {
+    std::array<int, BATCH>  res;
+
+    res.fill(0);
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            res[k] += __builtin_popcountll(this->words[i][k]);
+    return (res);
+}
+
+/*  the shifts by one cell are less than 64 bits, so each int64 only receives the bits overflowing from
+    its neighbour (as in the scalar BitBoard shifts), the shifts to the right being masked by the full board.
+    The int64 are updated in place, in the order that reads each neighbour before it is shifted itself.
+*/
+BitBoardBatch   &BitBoardBatch::shift_and(const uint8_t dir, BitBoardBatch const &mask) {
+    const int   s = BitBoard::shifts[dir];
+
+    if (s > 0) {
+        for (int i = NICB-1; i > 0; --i)
+            for (int k = 0; k < BATCH; ++k)
+                this->words[i][k] = ((this->words[i][k] >> s) | (this->words[i-1][k] << (BITS - s))) & BitBoard::full.word(i) & mask.words[i][k];
+        for (int k = 0; k < BATCH; ++k)
+            this->words[0][k] = (this->words[0][k] >> s) & BitBoard::full.word(0) & mask.words[0][k];
+    } else {
+        for (int i = 0; i < NICB-1; ++i)
+            for (int k = 0; k < BATCH; ++k)
+                this->words[i][k] = ((this->words[i][k] << -s) | (this->words[i+1][k] >> (BITS + s))) & mask.words[i][k];
+        for (int k = 0; k < BATCH; ++k)
+            this->words[NICB-1][k] = (this->words[NICB-1][k] << -s) & mask.words[NICB-1][k];
+    }
+    return (*this);
+}
+
+/*
+** Bitwise operator overload
+*/
+BitBoardBatch   BitBoardBatch::operator&(BitBoardBatch const &rhs) const {
+    BitBoardBatch   res = *this;
+    return (res &= rhs);
+}
+
+BitBoardBatch   BitBoardBatch::operator|(BitBoardBatch const &rhs) const {
+    BitBoardBatch   res = *this;
+    return (res |= rhs);
+}
+
+BitBoardBatch   BitBoardBatch::operator~(void) const {
+    BitBoardBatch   res;
+
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            res.words[i][k] = ~this->words[i][k];
+    return (res);
+}
+
+BitBoardBatch   &BitBoardBatch::operator&=(BitBoardBatch const &rhs) {
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            this->words[i][k] &= rhs.words[i][k];
+    return (*this);
+}
+
+BitBoardBatch   &BitBoardBatch::operator|=(BitBoardBatch const &rhs) {
+    for (int i = 0; i < NICB; ++i)
+        for (int k = 0; k < BATCH; ++k)
+            this->words[i][k] |= rhs.words[i][k];
+    return (*this);
+}
+
+/*
+** Non-member functions
+*/
+/* unlike the scalar detectors the scans are never stopped early, testing the lanes costs more than the remaining steps */
+uint32_t        five_detector(BitBoardBatch const &p1) {
+    uint32_t        res = 0;
+    BitBoardBatch   tmp;
+
+    for (int d = direction::north; d < 4; ++d) {
+        tmp = BitBoardBatch(BitBoard::full);
+        for (int n = 0; n < 5; ++n)
+            tmp.shift_and(d, p1);
+        res |= tmp.non_empty();
+    }
+    return (res);
+}
+
+BitBoardBatch   pair_capture_detector(BitBoardBatch const &p1, BitBoardBatch const &p2) {
+    const BitBoardBatch open_cells = ~p1 & ~p2 & BitBoardBatch(BitBoard::full);
+    BitBoardBatch       res;
+    BitBoardBatch       tmp;
+
+    for (int d = direction::north; d < 8; ++d) {
+        tmp = p1;
+        for (int n = 0; n < 3; ++n)
+            tmp.shift_and(d, (0xC0 << n & 0x80) == 0x80 ? p2 : open_cells);
+        res |= tmp;
+    }
+    return (res);
+}
@@ -1,6 +1,6 @@
 #include "Computer.hpp"
 
-Computer::Computer(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth) : Player(game_engine, gui, id, algo_type, depth) {
+Computer::Computer(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth, int threads, int smp_mode, size_t mcts_mb, int mcts_policy, size_t tt_mb) : Player(game_engine, gui, id, algo_type, depth, threads, smp_mode, mcts_mb, mcts_policy, tt_mb) {
     this->type = 1;
 }
 
@@ -28,8 +28,8 @@ bool        Computer::play(Player *other) {
     action_beg = std::chrono::steady_clock::now();
 
     t_ret ret = (*this->_ai_algorithm)(root);
-    action.pos = { range(ret.p / 19, 0, 18), range(ret.p % 19, 0, 18) };
-    this->_gui->explored_moves = get_moves(root.player, root.opponent, forbidden_detector(root.player, root.opponent), root.player_pairs_captured, root.opponent_pairs_captured);
+    action.pos = { range(ret.p / BOARD_SIZE, 0, BOARD_SIZE - 1), range(ret.p % BOARD_SIZE, 0, BOARD_SIZE - 1) };
+    this->_gui->explored_moves = get_moves(root.player, root.opponent, root.player_forbidden, root.player_pairs_captured, root.opponent_pairs_captured);
     action.duration = std::chrono::steady_clock::now() - action_beg;
     action.timepoint = std::chrono::steady_clock::now() - this->_game_engine->get_initial_timepoint();
     action.id = this->_game_engine->get_history_size() + 1;
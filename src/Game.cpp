@@ -27,8 +27,8 @@ Game    &Game::operator=(Game const &src) {
 }
 
 void    Game::_configure(void) {
-    this->_player_1 = ( this->_config[this->_config.find("p1=")+3]=='H' ? (Player*)new Human(this->_game_engine, this->_gui, 1, options::g_optionsp1.algo_type, options::g_optionsp1.depth) : (Player*)new Computer(this->_game_engine, this->_gui, 1, options::g_optionsp1.algo_type, options::g_optionsp1.depth) );
-    this->_player_2 = ( this->_config[this->_config.find("p2=")+3]=='H' ? (Player*)new Human(this->_game_engine, this->_gui, 2, options::g_optionsp2.algo_type, options::g_optionsp2.depth) : (Player*)new Computer(this->_game_engine, this->_gui, 2, options::g_optionsp2.algo_type, options::g_optionsp2.depth) );
+    this->_player_1 = ( this->_config[this->_config.find("p1=")+3]=='H' ? (Player*)new Human(this->_game_engine, this->_gui, 1, options::g_optionsp1.algo_type, options::g_optionsp1.depth, options::g_optionsp1.threads, options::g_optionsp1.smp, options::g_optionsp1.mcts_mb, options::g_optionsp1.mcts_policy, options::g_optionsp1.tt_mb) : (Player*)new Computer(this->_game_engine, this->_gui, 1, options::g_optionsp1.algo_type, options::g_optionsp1.depth, options::g_optionsp1.threads, options::g_optionsp1.smp, options::g_optionsp1.mcts_mb, options::g_optionsp1.mcts_policy, options::g_optionsp1.tt_mb) );
+    this->_player_2 = ( this->_config[this->_config.find("p2=")+3]=='H' ? (Player*)new Human(this->_game_engine, this->_gui, 2, options::g_optionsp2.algo_type, options::g_optionsp2.depth, options::g_optionsp2.threads, options::g_optionsp2.smp, options::g_optionsp2.mcts_mb, options::g_optionsp2.mcts_policy, options::g_optionsp2.tt_mb) : (Player*)new Computer(this->_game_engine, this->_gui, 2, options::g_optionsp2.algo_type, options::g_optionsp2.depth, options::g_optionsp2.threads, options::g_optionsp2.smp, options::g_optionsp2.mcts_mb, options::g_optionsp2.mcts_policy, options::g_optionsp2.tt_mb) );
     this->_gui->set_nu((this->_config[this->_config.find("nu=")+3]=='1' ? true : false));
     this->_gui->set_db((this->_config[this->_config.find("db=")+3]=='1' ? true : false));
     this->_gui->set_sg((this->_config[this->_config.find("sg=")+3]=='1' ? true : false));
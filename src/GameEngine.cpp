@@ -66,7 +66,7 @@ uint8_t check_end(BitBoard const& p1, BitBoard const& p2, uint8_t const& p1_pair
 
 void    GameEngine::update_game_state(t_action &action, Player *p1, Player *p2) {
     p1->board.write(action.pos[1], action.pos[0]);
-    BitBoard captured = highlight_captured_stones(p1->board, p2->board, (action.pos[0] * 19 + action.pos[1]) );
+    BitBoard captured = highlight_captured_stones(p1->board, p2->board, (action.pos[0] * BOARD_SIZE + action.pos[1]) );
     if (!captured.is_empty()) {
         p1->set_pairs_captured(p1->get_pairs_captured() + captured.set_count() / 2);
         p2->board &= ~captured;
@@ -79,10 +79,10 @@ void    GameEngine::update_game_state(t_action &action, Player *p1, Player *p2)
 
 void GameEngine::update_grid_with_bitboard(BitBoard const &bitboard, int8_t const &state) {
     uint64_t    row;
-    for (uint8_t y = 0; y < 19; y++) {
+    for (uint8_t y = 0; y < BOARD_ROWS; y++) {
         row = bitboard.row(y);
         if (row) {
-            for (uint8_t x = 0; x < 19; x++)
+            for (uint8_t x = 0; x < BOARD_COLS; x++)
                 if (row << x & 0x8000000000000000)
                     this->grid(y, x) = state;
         }
@@ -139,27 +139,22 @@ void    GameEngine::delete_last_action(Player *p1, Player *p2) {
 Eigen::Array22i GameEngine::get_end_line(BitBoard const &bitboard) {
     BitBoard        tmp;
     Eigen::Array22i pos;
-    int64_t p = -1;
-    uint64_t off;
+    int64_t         p;
+    int64_t         off;
 
     pos << 0, 0, 0, 0;
     for (uint8_t d = 0; d < 8; d++) {
         tmp = bitboard;
         for (int n = 1; !tmp.is_empty(); ++n) {
-            tmp = (d > 0 && d < 4 ? tmp & ~BitBoard::border_right : (d > 4 && d < 8 ? tmp & ~BitBoard::border_left : tmp));
             tmp &= tmp.shifted(d);
-            if (n >= 4) {
-                for (uint8_t v = 0; v < 6; v++) {
-                    if (tmp.values[v]) {
-                        while (p++ < BITS) if (0x8000000000000000 & (tmp.values[v] << p)) break;
-                        off = BitBoard::shifts[(d < 4 ? d + 4 : d - 4)] * n;
-                        pos << (BITS * v + p + off) % 19,
-                               (BITS * v + p + off) / 19,
-                               (BITS * v + p) % 19,
-                               (BITS * v + p) / 19;
-                        return (pos);
-                    }
-                }
+            if (n >= 4 && !tmp.is_empty()) {
+                p = BitBoard::cell_to_bit(*tmp.begin());
+                off = BitBoard::shifts[(d < 4 ? d + 4 : d - 4)] * n;
+                pos << (p + off) % STRIDE,
+                       (p + off) / STRIDE,
+                       p % STRIDE,
+                       p / STRIDE;
+                return (pos);
             }
         }
     }
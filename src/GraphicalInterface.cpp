@@ -241,7 +241,7 @@ void    GraphicalInterface::update_display(void) {
 
 void    GraphicalInterface::update_end_game(Player const &p1, Player const &p2) {
     const Eigen::Array2i    move = (this->_game_engine->get_history_size() == 0 ? (Eigen::Array2i){ 0, 0 } : this->_game_engine->get_history()->back().pos);
-    uint8_t end = check_end(p1.board, p2.board, p1.get_pairs_captured(), p2.get_pairs_captured(), move[0] * 19 + move[1]);
+    uint8_t end = check_end(p1.board, p2.board, p1.get_pairs_captured(), p2.get_pairs_captured(), move[0] * BOARD_SIZE + move[1]);
 
     if (end == end::none) {
         this->_winning_text = "";
@@ -331,10 +331,10 @@ void    GraphicalInterface::_render_forbidden(void) {
     SDL_Rect        rect;
     uint64_t        row;
 
-    for (uint8_t y = 0; y < 19; y++) {
+    for (uint8_t y = 0; y < ROWS; y++) {
         row = this->_analytics->get_c_player()->board_forbidden.row(y);
         if (row) {
-            for (uint8_t x = 0; x < 19; x++)
+            for (uint8_t x = 0; x < COLS; x++)
                 if (row << x & 0x8000000000000000) {
                     s_pos = this->grid_to_screen((Eigen::Array2i){y, x});
                     size = { this->_forbidden_rect.w*3, this->_forbidden_rect.h*1.5 };
@@ -370,13 +370,11 @@ void    GraphicalInterface::_render_explored(void) {
     Eigen::Array2i  g_pos;
     SDL_Rect        rect;
 
-    for (int i = 0; i < 361; ++i) {
-        if (this->explored_moves.check_bit(i)) {
-            g_pos = { i / 19, i % 19 };
-            s_pos = this->grid_to_screen(g_pos);
-            rect = {s_pos[1] - (this->_stone_size-10) / 2, s_pos[0] - (this->_stone_size-10) / 2, this->_stone_size-10, this->_stone_size-10};
-            SDL_RenderCopy(this->_renderer, this->_explored_move_tex, NULL, &rect);
-        }
+    for (int i : this->explored_moves) {
+        g_pos = { i / BOARD_SIZE, i % BOARD_SIZE };
+        s_pos = this->grid_to_screen(g_pos);
+        rect = {s_pos[1] - (this->_stone_size-10) / 2, s_pos[0] - (this->_stone_size-10) / 2, this->_stone_size-10, this->_stone_size-10};
+        SDL_RenderCopy(this->_renderer, this->_explored_move_tex, NULL, &rect);
     }
 }
 
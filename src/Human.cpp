@@ -1,6 +1,6 @@
 #include "Human.hpp"
 
-Human::Human(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth) : Player(game_engine, gui, id, algo_type, depth) {
+Human::Human(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth, int threads, int smp_mode, size_t mcts_mb, int mcts_policy, size_t tt_mb) : Player(game_engine, gui, id, algo_type, depth, threads, smp_mode, mcts_mb, mcts_policy, tt_mb) {
     this->_action_duration = std::chrono::steady_clock::duration::zero();
     this->type = 0;
 }
@@ -26,7 +26,7 @@ bool    Human::play(Player *other) {
     if (this->_gui->get_sg() && this->suggested_move(0) == -1) {
         t_node  root = create_node(*this, *other);
         t_ret ret = (*this->_ai_algorithm)(root);
-        this->suggested_move = { range(ret.p / 19, 0, 18), range(ret.p % 19, 0, 18) };
+        this->suggested_move = { range(ret.p / BOARD_SIZE, 0, BOARD_SIZE - 1), range(ret.p % BOARD_SIZE, 0, BOARD_SIZE - 1) };
     }
     if (this->_action_duration == std::chrono::steady_clock::duration::zero())
         this->_action_duration = this->_gui->get_analytics()->get_chronometer()->get_elapsed();
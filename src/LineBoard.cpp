@@ -0,0 +1,291 @@
+#include "LineBoard.hpp"
+
+/* compute the line and position of each cell, for each axis (see LineBoard.hpp for the line indices) */
+static const std::array<std::array<t_line_pos, AXES>, CELLS>    init_cells(void) {
+    const int                                       n = BOARD_SIZE;
+    std::array<std::array<t_line_pos, AXES>, CELLS> cells;
+
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            cells[n * y + x][axis::row] = (t_line_pos){ (uint8_t)y, (uint8_t)x };
+            cells[n * y + x][axis::column] = (t_line_pos){ (uint8_t)(n + x), (uint8_t)y };
+            cells[n * y + x][axis::diagonal] = (t_line_pos){ (uint8_t)(2 * n + n - 1 + y - x), (uint8_t)(x < y ? x : y) };
+            cells[n * y + x][axis::anti_diagonal] = (t_line_pos){ (uint8_t)(4 * n - 1 + x + y), (uint8_t)(x + y > n - 1 ? n - 1 - x : y) };
+        }
+    }
+    return (cells);
+}
+
+static const std::array<uint8_t, LINES>                         init_lengths(void) {
+    const int                   n = BOARD_SIZE;
+    std::array<uint8_t, LINES>  lengths;
+
+    for (int i = 0; i < 2 * n; ++i)
+        lengths[i] = n;
+    for (int i = 0; i < 2 * n - 1; ++i) {
+        lengths[2 * n + i] = n - (i < n - 1 ? n - 1 - i : i - (n - 1));
+        lengths[4 * n - 1 + i] = n - (i < n - 1 ? n - 1 - i : i - (n - 1));
+    }
+    return (lengths);
+}
+
+static const std::array<std::array<uint16_t, BOARD_SIZE>, LINES>    init_positions(std::array<std::array<t_line_pos, AXES>, CELLS> const &cells) {
+    std::array<std::array<uint16_t, BOARD_SIZE>, LINES> positions;
+
+    for (int i = 0; i < CELLS; ++i)
+        for (int a = 0; a < AXES; ++a)
+            positions[cells[i][a].line][cells[i][a].pos] = i;
+    return (positions);
+}
+
+/* the base 3 value of the first WINDOW bits of a line (bit n giving 3^n), a window index being ternary[p1] + 2 * ternary[p2] */
+static const std::array<uint16_t, 1 << WINDOW>              init_ternary(void) {
+    std::array<uint16_t, 1 << WINDOW>   ternary;
+
+    for (int m = 0; m < (1 << WINDOW); ++m) {
+        ternary[m] = 0;
+        for (int n = 0, p = 1; n < WINDOW; ++n, p *= 3)
+            ternary[m] += ((m >> n) & 1) * p;
+    }
+    return (ternary);
+}
+
+/*  for each window of WINDOW cells (0 : empty, 1 : p1, 2 : p2), count the occurrences of each of the
+    BitBoard::patterns in both reading directions (only one for the patterns checked on 4 directions)
+    with the same rules as `pattern_detector` : the cell before the pattern must be a p2 stone for
+    the close patterns, and can be anything for the others. Only the occurrences ending in the last 3
+    cells of the window are counted, so that a line read with windows stepping by 3 counts each
+    occurrence once. The count of the pattern i is stored in the byte i of the entry.
+*/
+static const std::array<uint64_t, WINDOWS>                  init_pattern_table(void) {
+    std::array<uint64_t, WINDOWS>   table;
+    uint8_t                         cells[WINDOW];
+
+    for (int w = 0; w < WINDOWS; ++w) {
+        table[w] = 0;
+        for (int n = 0, v = w; n < WINDOW; ++n, v /= 3)
+            cells[n] = v % 3;
+        for (int i = 0; i < 8; ++i) {
+            const t_pattern pattern = BitBoard::patterns[i];
+            const bool      closed = ((pattern.repr & 0x80) | (0x1 << (8-pattern.size) & pattern.repr)) == 0x80;
+            for (int r = 0; r < (pattern.dirs == 8 ? 2 : 1); ++r) {
+                for (int a = WINDOW - 3 - pattern.size; a < WINDOW - pattern.size; ++a) { /* the occurrence spans [a, a + size] */
+                    const int   before = (r == 0 ? a : a + pattern.size);
+                    bool        match = (!closed || cells[before] == 2);
+                    for (int n = 0; n < pattern.size && match; ++n)
+                        match = (cells[r == 0 ? a + 1 + n : a + pattern.size - 1 - n] == ((pattern.repr << n & 0x80) ? 1 : 0));
+                    table[w] += (uint64_t)match << (8 * i);
+                }
+            }
+        }
+    }
+    return (table);
+}
+
+/* assignation of static variables */
+const std::array<std::array<t_line_pos, AXES>, CELLS>       LineBoard::cells = init_cells();
+const std::array<uint8_t, LINES>                            LineBoard::lengths = init_lengths();
+const std::array<std::array<uint16_t, BOARD_SIZE>, LINES>   LineBoard::positions = init_positions(LineBoard::cells);
+
+LineBoard::LineBoard(void) {
+    this->zeros();
+}
+
+LineBoard::LineBoard(BitBoard const &board) {
+    this->zeros();
+    for (int i : board)
+        this->write(i);
+}
+
+void        LineBoard::zeros(void) {
+    this->lines.fill(0);
+}
+
+void        LineBoard::write(const int i) {
+    for (int a = 0; a < AXES; ++a)
+        this->lines[LineBoard::cells[i][a].line] |= (1 << LineBoard::cells[i][a].pos);
+}
+
+void        LineBoard::remove(const int i) {
+    for (int a = 0; a < AXES; ++a)
+        this->lines[LineBoard::cells[i][a].line] &= ~(1 << LineBoard::cells[i][a].pos);
+}
+
+void        LineBoard::remove(BitBoard const &stones) {
+    for (int i : stones)
+        this->remove(i);
+}
+
+uint32_t    LineBoard::line(const int axis, const int i) const {
+    return (this->lines[LineBoard::cells[i][axis].line]);
+}
+
+bool        LineBoard::check_bit(const int i) const {
+    return ((this->lines[LineBoard::cells[i][axis::row].line] >> LineBoard::cells[i][axis::row].pos) & 1);
+}
+
+/*
+** Non-member functions
+*/
+/*  return the packed pattern counts of a line (in 16-bit fields, even patterns in `lo` and odd in `hi`).
+    The lines are moved by 8 bits so that the first windows can start before the line, the cells
+    beyond the line being p2 stones.
+*/
+static inline void  line_pattern_count(uint32_t p1, uint32_t p2, int length, uint64_t &lo, uint64_t &hi) {
+    static const std::array<uint16_t, 1 << WINDOW>  ternary = init_ternary();
+    static const std::array<uint64_t, WINDOWS>      table = init_pattern_table();
+    const uint64_t  a = (uint64_t)p1 << 8;
+    const uint64_t  b = ((uint64_t)p2 << 8) | ~(((1ULL << length) - 1) << 8);
+    uint64_t        res = 0;
+    uint64_t        w;
+
+    for (int s = 6; s <= length + 2; s += 3) { /* the windows start at -2 (the first cell that can end a pattern is the 4th) */
+        if ((w = (a >> s) & 0x1FF)) /* no pattern without p1 stones */
+            res += table[ternary[w] + 2 * ternary[(b >> s) & 0x1FF]];
+    }
+    lo += res & 0x00FF00FF00FF00FF;
+    hi += (res >> 8) & 0x00FF00FF00FF00FF;
+}
+
+static inline std::array<int, 8>    unpack_pattern_count(uint64_t lo, uint64_t hi) {
+    std::array<int, 8>  counts;
+
+    for (int i = 0; i < 4; ++i) {
+        counts[2 * i] = (lo >> (16 * i)) & 0xFFFF;
+        counts[2 * i + 1] = (hi >> (16 * i)) & 0xFFFF;
+    }
+    return (counts);
+}
+
+std::array<int, 8>  pattern_count(LineBoard const &p1, LineBoard const &p2) {
+    uint64_t    lo = 0;
+    uint64_t    hi = 0;
+
+    for (int n = 0; n < LINES; ++n)
+        if (LineBoard::lengths[n] >= 5 && p1.lines[n])
+            line_pattern_count(p1.lines[n], p2.lines[n], LineBoard::lengths[n], lo, hi);
+    return (unpack_pattern_count(lo, hi));
+}
+
+std::array<int, 8>  pattern_count(LineBoard const &p1, LineBoard const &p2, BitBoard const &stones) {
+    std::array<uint64_t, 2> seen = {{0, 0}};
+    uint64_t                lo = 0;
+    uint64_t                hi = 0;
+    uint8_t                 n;
+
+    for (int i : stones) {
+        for (int a = 0; a < AXES; ++a) {
+            n = LineBoard::cells[i][a].line;
+            if (LineBoard::lengths[n] >= 5 && p1.lines[n] && !(seen[n >> 6] & (1ULL << (n & 0x3F))))
+                line_pattern_count(p1.lines[n], p2.lines[n], LineBoard::lengths[n], lo, hi);
+            seen[n >> 6] |= (1ULL << (n & 0x3F));
+        }
+    }
+    return (unpack_pattern_count(lo, hi));
+}
+
+/* return the positions c of the line for which c + k (in the reading direction of the line) is in `line` */
+template <bool Reversed>
+static inline uint32_t  line_at(uint32_t line, int k) {
+    return ((k > 0) != Reversed ? line >> (k > 0 ? k : -k) : line << (k > 0 ? k : -k));
+}
+
+/* return the cells where placing a stone completes the pattern, for every index j of the missing stone */
+template <uint8_t Pattern, int Length, bool Reversed>
+static inline uint32_t  pattern_cells(uint32_t stones, uint32_t open_cells, uint32_t full) {
+    uint32_t    res = 0;
+    uint32_t    tmp;
+
+    for (int j = 0; j < Length; ++j) {
+        if (!(Pattern << j & 0x80))
+            continue;
+        tmp = open_cells & line_at<Reversed>(full, -(j + 1)); /* the cell before the pattern is on the board */
+        for (int k = 0; k < Length; ++k)
+            if (k != j)
+                tmp &= line_at<Reversed>((Pattern << k & 0x80) ? stones : open_cells, k - j);
+        res |= tmp;
+    }
+    return (res);
+}
+
+template <bool Reversed>
+static inline uint32_t  line_three_cells(uint32_t stones, uint32_t open_cells, uint32_t full) {
+    return (pattern_cells<0x58, 6, Reversed>(stones, open_cells, full)      // -O-OO-
+        | pattern_cells<0x68, 6, Reversed>(stones, open_cells, full)        // -OO-O-
+        | pattern_cells<0x70, 5, Reversed>(stones, open_cells, full));      // -OOO-
+}
+
+/*  The rows and the diagonals are read by forbidden_detector from their first cell to their last, the
+    columns and the anti-diagonals from their last cell to their first, and the cell before a pattern
+    has to be on the board : the reading direction only matters for the patterns at the end of a line.
+*/
+uint32_t    three_cells(LineBoard const &p1, LineBoard const &p2, const int n) {
+    const uint32_t  full = (1U << LineBoard::lengths[n]) - 1;
+    const uint32_t  open_cells = ~p1.lines[n] & ~p2.lines[n] & full;
+
+    if ((n >= BOARD_SIZE && n < 2 * BOARD_SIZE) || n >= 4 * BOARD_SIZE - 1)
+        return (line_three_cells<true>(p1.lines[n], open_cells, full));
+    return (line_three_cells<false>(p1.lines[n], open_cells, full));
+}
+
+/* a cell is forbidden if it completes a free three on two of its axes */
+static inline bool  is_forbidden(std::array<uint32_t, LINES> const &threes, const int i) {
+    int     count = 0;
+
+    for (int a = 0; a < AXES; ++a)
+        count += (threes[LineBoard::cells[i][a].line] >> LineBoard::cells[i][a].pos) & 1;
+    return (count >= 2);
+}
+
+BitBoard    forbidden_detector(LineBoard const &p1, LineBoard const &p2, std::array<uint32_t, LINES> &threes) {
+    BitBoard    res;
+
+    for (int n = 0; n < LINES; ++n)
+        threes[n] = (__builtin_popcount(p1.lines[n]) >= 2 ? three_cells(p1, p2, n) : 0);
+    for (int i = 0; i < CELLS; ++i)
+        if (is_forbidden(threes, i))
+            res.write(i);
+    return (res);
+}
+
+/*  only the cells whose three_cells changed on one of the lines can change, which are the cells
+    in a radius of 5 around the given stones on these lines.
+*/
+void        update_forbidden(LineBoard const &p1, LineBoard const &p2, BitBoard const &stones, std::array<uint32_t, LINES> &threes, BitBoard &forbidden) {
+    std::array<uint64_t, 2> seen = {{0, 0}};
+    uint32_t                next;
+    uint32_t                diff;
+    uint8_t                 n;
+    int                     c;
+
+    for (int i : stones) {
+        for (int a = 0; a < AXES; ++a) {
+            n = LineBoard::cells[i][a].line;
+            if (seen[n >> 6] & (1ULL << (n & 0x3F)))
+                continue;
+            seen[n >> 6] |= (1ULL << (n & 0x3F));
+            if (!threes[n] && __builtin_popcount(p1.lines[n]) < 2) /* no three before, and not enough stones for one */
+                continue;
+            next = three_cells(p1, p2, n);
+            diff = next ^ threes[n];
+            threes[n] = next;
+            for (; diff; diff &= diff - 1) {
+                c = LineBoard::positions[n][__builtin_ctz(diff)];
+                if (is_forbidden(threes, c))
+                    forbidden.write(c);
+                else
+                    forbidden.remove(c);
+            }
+        }
+    }
+}
+
+std::ostream	&operator<<(std::ostream &os, LineBoard const &lineboard) {
+    for (int n = 0; n < LINES; ++n) {
+        os << (n < 10 ? "  " : (n < 100 ? " " : "")) << n << " | ";
+        for (int p = 0; p < LineBoard::lengths[n]; ++p)
+            os << (((lineboard.lines[n] >> p) & 1) ? "O " : ". ");
+        os << std::endl;
+    }
+    return (os);
+}
@@ -0,0 +1,144 @@
+#include <vector>
+#include <algorithm>
+#include "MCTSArena.hpp"
+
+MCTSArena::MCTSArena(size_t size_mb) : _nodes(nullptr), _capacity(0), _size_mb(0), _size(0) {
+    this->resize(size_mb);
+}
+
+MCTSArena::~MCTSArena(void) {
+    delete[] this->_nodes;
+}
+
+size_t      MCTSArena::size(void) const {
+    size_t  size = this->_size.load(std::memory_order_relaxed);
+
+    return (size < this->_capacity ? size : this->_capacity);
+}
+
+/* the nodes are default-initialized (their atomics are trivial), so the pages are only touched once used */
+void        MCTSArena::resize(size_t size_mb) {
+    delete[] this->_nodes;
+    this->_nodes = nullptr;
+    this->_capacity = ((size_mb ? size_mb : 1) << 20) / sizeof(t_mcts_node);
+    this->_nodes = new t_mcts_node[this->_capacity];
+    this->_size_mb = size_mb;
+    this->clear();
+}
+
+void        MCTSArena::clear(void) {
+    this->_size.store(0, std::memory_order_relaxed);
+}
+
+/*  the nodes of the subtree keep their relative order, so each one is moved to an index lower or equal to
+    its own, after the nodes kept before it : the subtree is compacted in place, without overwriting a node
+    not moved yet. The statistics of the subtree are kept, the other nodes are forgotten.
+*/
+int32_t     MCTSArena::compact(int32_t root) {
+    std::vector<int32_t>    kept(1, root);
+    std::vector<int32_t>    index(this->size(), -1);    /* the new index of each node kept */
+    t_mcts_node             *from;
+    t_mcts_node             *to;
+    int32_t                 first_child;
+    int32_t                 next_sibling;
+    int32_t                 parent;
+
+    for (size_t k = 0; k < kept.size(); ++k)
+        for (int32_t child = this->_nodes[kept[k]].first_child.load(std::memory_order_relaxed); child != -1; child = this->_nodes[child].next_sibling)
+            kept.push_back(child);
+    std::sort(kept.begin(), kept.end());
+    for (size_t k = 0; k < kept.size(); ++k)
+        index[kept[k]] = k;
+    for (size_t k = 0; k < kept.size(); ++k) {
+        from = &this->_nodes[kept[k]];
+        to = &this->_nodes[k];
+        first_child = from->first_child.load(std::memory_order_relaxed);
+        next_sibling = (kept[k] == root ? -1 : from->next_sibling);
+        parent = (kept[k] == root ? -1 : from->parent);
+        to->wins.store(from->wins.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to->visit.store(from->visit.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to->first_child.store(first_child == -1 ? -1 : index[first_child], std::memory_order_relaxed);
+        to->next_sibling = (next_sibling == -1 ? -1 : index[next_sibling]);
+        to->parent = (parent == -1 ? -1 : index[parent]);
+        to->move = from->move;
+        to->playerid = from->playerid;
+        to->expanding.store(from->expanding.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to->proven.store(from->proven.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to->childs = from->childs;
+        to->prior = from->prior;
+        for (int w = 0; w < NICB; ++w)
+            to->untried[w].store(from->untried[w].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    this->_size.store(kept.size(), std::memory_order_relaxed);
+    return (index[root]);
+}
+
+int32_t     MCTSArena::create(int32_t parent, int move, BitBoard const &moves) {
+    size_t      i = this->_size.fetch_add(1, std::memory_order_relaxed);
+    t_mcts_node *node;
+
+    if (i >= this->_capacity)
+        return (-1);
+    node = &this->_nodes[i];
+    node->wins.store(0, std::memory_order_relaxed);
+    node->visit.store(0, std::memory_order_relaxed);
+    node->first_child.store(-1, std::memory_order_relaxed);
+    node->next_sibling = -1;
+    node->parent = parent;
+    node->move = move;
+    node->playerid = (parent >= 0 && this->_nodes[parent].playerid == 1 ? 2 : 1);
+    node->expanding.store(false, std::memory_order_relaxed);
+    node->proven.store(0, std::memory_order_relaxed);
+    node->childs = moves.set_count();
+    node->prior = 0;
+    for (int w = 0; w < NICB; ++w)
+        node->untried[w].store(moves.word(w), std::memory_order_relaxed);
+    return ((int32_t)i);
+}
+
+/*  the words are visited from a random one, and the bits of a word from a random position (the
+    leftmost set bit once the word is rotated), so the moves are expanded in a random order
+*/
+int         MCTSArena::claim(int32_t node, uint32_t random) {
+    std::atomic<uint64_t>   *untried = this->_nodes[node].untried;
+    uint64_t                bits;
+    uint64_t                mask;
+    int                     w;
+    int                     r = random & 63;
+    int                     pos;
+
+    for (int k = 0; k < NICB; ++k) {
+        w = (random / 64 + k) % NICB;
+        bits = untried[w].load(std::memory_order_relaxed);
+        while (bits) {
+            pos = (__builtin_clzll(r ? (bits << r) | (bits >> (64 - r)) : bits) + r) & 63;
+            mask = 0x8000000000000000 >> pos;
+            bits = untried[w].fetch_and(~mask, std::memory_order_relaxed);
+            if (bits & mask)
+                return (BitBoard::bit_to_cell((w << 6) + pos));
+            bits &= ~mask;
+        }
+    }
+    return (-1);
+}
+
+void        MCTSArena::release(int32_t node, int move) {
+    int     bit = BitBoard::cell_to_bit(move);
+
+    this->_nodes[node].untried[bit >> 6].fetch_or(0x8000000000000000 >> (bit & 63), std::memory_order_relaxed);
+}
+
+void        MCTSArena::add_child(int32_t node, int32_t child) {
+    t_mcts_node &parent = this->_nodes[node];
+
+    this->_nodes[child].next_sibling = parent.first_child.load(std::memory_order_relaxed);
+    while (!parent.first_child.compare_exchange_weak(this->_nodes[child].next_sibling, child, std::memory_order_release, std::memory_order_relaxed))
+        ;
+}
+
+bool        MCTSArena::is_fully_expanded(int32_t node) const {
+    for (int w = 0; w < NICB; ++w)
+        if (this->_nodes[node].untried[w].load(std::memory_order_relaxed))
+            return (false);
+    return (true);
+}
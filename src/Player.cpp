@@ -1,6 +1,6 @@
 #include "Player.hpp"
 
-Player::Player(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth) : _game_engine(game_engine), _gui(gui), _id(id), _pairs_captured(0) {
+Player::Player(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int algo_type, int depth, int threads, int smp_mode, size_t mcts_mb, int mcts_policy, size_t tt_mb) : _game_engine(game_engine), _gui(gui), _id(id), _pairs_captured(0) {
     this->suggested_move = { -1, -1 };
     this->current_score = 0;
     if (algo_type == 2)
@@ -8,11 +8,11 @@ Player::Player(GameEngine *game_engine, GraphicalInterface *gui, uint8_t id, int
     else if (algo_type == 3)
         this->_ai_algorithm = (AIPlayer*)new AlphaBeta(depth, id, verbose::quiet);
     else if (algo_type == 4)
-        this->_ai_algorithm = (AIPlayer*)new MTDf(depth, id, verbose::quiet);
+        this->_ai_algorithm = (AIPlayer*)new MTDf(depth, id, verbose::quiet, tt_mb);
     else if (algo_type == 5)
-        this->_ai_algorithm = (AIPlayer*)new MCTS(depth, id, verbose::quiet);
+        this->_ai_algorithm = (AIPlayer*)new MCTS(depth, id, verbose::quiet, 499, threads, mcts_mb, mcts_policy);
     else
-        this->_ai_algorithm = (AIPlayer*)new AlphaBetaCustom(depth, id, verbose::quiet);
+        this->_ai_algorithm = (AIPlayer*)new AlphaBetaCustom(depth, id, verbose::quiet, 500, threads, smp_mode, tt_mb);
 }
 
 Player::Player(Player const &src) : _game_engine(src.get_game_engine()), _id(src.get_id()) {
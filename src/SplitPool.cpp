@@ -0,0 +1,53 @@
+#include "SplitPool.hpp"
+
+SplitPool::SplitPool(int workers) : _quit(false) {
+    for (int w = 0; w < (workers > 1 ? workers : 1); ++w)
+        this->_queues.push_back(std::unique_ptr<t_queue>(new t_queue));
+    for (int w = 1; w < this->size(); ++w)
+        this->_threads.push_back(std::thread(&SplitPool::_work, this, w));
+}
+
+SplitPool::~SplitPool(void) {
+    this->_quit = true;
+    for (std::vector<std::thread>::iterator thread = this->_threads.begin(); thread != this->_threads.end(); ++thread)
+        thread->join();
+}
+
+void        SplitPool::push(int worker, t_task const &task) {
+    std::lock_guard<std::mutex> guard(this->_queues[worker]->lock);
+
+    this->_queues[worker]->tasks.push_back(task);
+}
+
+bool        SplitPool::run_one(int worker) {
+    t_task  task;
+    t_queue *queue;
+
+    /* the last task pushed by the worker itself */
+    {
+        std::lock_guard<std::mutex> guard(this->_queues[worker]->lock);
+        if (!this->_queues[worker]->tasks.empty()) {
+            task = this->_queues[worker]->tasks.back();
+            this->_queues[worker]->tasks.pop_back();
+        }
+    }
+    /* otherwise the first task of the next worker having one */
+    for (int w = 1; !task && w < this->size(); ++w) {
+        queue = this->_queues[(worker + w) % this->size()].get();
+        std::lock_guard<std::mutex> guard(queue->lock);
+        if (!queue->tasks.empty()) {
+            task = queue->tasks.front();
+            queue->tasks.pop_front();
+        }
+    }
+    if (!task)
+        return (false);
+    task(worker);
+    return (true);
+}
+
+void        SplitPool::_work(int worker) {
+    while (!this->_quit.load(std::memory_order_relaxed))
+        if (!this->run_one(worker))
+            std::this_thread::yield();
+}
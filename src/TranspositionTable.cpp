@@ -0,0 +1,121 @@
+#include <cstdlib>
+#include <new>
+#include "TranspositionTable.hpp"
+
+static inline uint64_t  pack(int score, int move, int depth, uint8_t flag_age) {
+    return ((uint64_t)(uint32_t)score | (uint64_t)(uint16_t)move << 32 | (uint64_t)(uint8_t)depth << 48 | (uint64_t)flag_age << 56);
+}
+
+TranspositionTable::TranspositionTable(size_t size_mb) : _buckets(nullptr), _mask(0), _size_mb(0), _age(1) {
+    this->resize(size_mb);
+}
+
+TranspositionTable::TranspositionTable(TranspositionTable const &src) : _buckets(nullptr), _mask(0), _size_mb(0), _age(1) {
+    *this = src;
+}
+
+TranspositionTable::~TranspositionTable(void) {
+    std::free(this->_buckets);
+}
+
+TranspositionTable  &TranspositionTable::operator=(TranspositionTable const &rhs) {
+    if (this != &rhs) {
+        this->resize(rhs._size_mb);
+        for (size_t b = 0; b <= this->_mask; ++b) {
+            for (int i = 0; i < TT_BUCKET; ++i) {
+                this->_buckets[b].entries[i].key.store(rhs._buckets[b].entries[i].key.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                this->_buckets[b].entries[i].data.store(rhs._buckets[b].entries[i].data.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+        this->_age = rhs._age;
+    }
+    return (*this);
+}
+
+/* the number of buckets is the largest power of two fitting in `size_mb` */
+void        TranspositionTable::resize(size_t size_mb) {
+    size_t  count = 1;
+    void    *buckets = nullptr;
+
+    while (count * 2 * sizeof(t_tt_bucket) <= (size_mb ? size_mb : 1) << 20)
+        count *= 2;
+    this->_size_mb = size_mb;
+    if (this->_buckets && count == this->_mask + 1)
+        return ;
+    if (posix_memalign(&buckets, sizeof(t_tt_bucket), count * sizeof(t_tt_bucket)) != 0)
+        throw std::bad_alloc();
+    std::free(this->_buckets);
+    this->_buckets = (t_tt_bucket *)buckets;
+    this->_mask = count - 1;
+    this->clear();
+}
+
+void        TranspositionTable::clear(void) {
+    for (size_t b = 0; b <= this->_mask; ++b) {
+        for (int i = 0; i < TT_BUCKET; ++i) {
+            this->_buckets[b].entries[i].key.store(0, std::memory_order_relaxed);
+            this->_buckets[b].entries[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+    this->_age = 1;
+}
+
+void        TranspositionTable::new_search(void) {
+    this->_age = (this->_age + 1) % TT_AGES;
+    if (this->_age == 0)
+        this->_age = 1;
+}
+
+bool        TranspositionTable::probe(uint64_t hash, t_stored &stored) const {
+    t_tt_entry const    *entries = this->_buckets[hash & this->_mask].entries;
+    uint64_t            data;
+
+    for (int i = 0; i < TT_BUCKET; ++i) {
+        data = entries[i].data.load(std::memory_order_relaxed);
+        if ((entries[i].key.load(std::memory_order_relaxed) ^ data) == hash && data >> 56) {
+            stored.score = (int32_t)(uint32_t)data;
+            stored.move = (int16_t)(data >> 32);
+            stored.depth = (int8_t)(data >> 48);
+            stored.flag = (data >> 56) & 0x3;
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/*  the entry of the same position is only overwritten by a search at least as deep or by a newer search
+    (keeping its move if the new one has none), otherwise an empty entry is used, otherwise the entry with
+    the lowest depth once penalized by its age (relative to the current search)
+*/
+void        TranspositionTable::store(uint64_t hash, int score, int move, int depth, uint8_t flag) {
+    t_tt_entry  *entries = this->_buckets[hash & this->_mask].entries;
+    t_tt_entry  *replaced = &entries[0];
+    uint64_t    data;
+    int         value;
+    int         lowest = 0;
+
+    move = (move >= 0 && move < CELLS ? move : -1);
+    for (int i = 0; i < TT_BUCKET; ++i) {
+        data = entries[i].data.load(std::memory_order_relaxed);
+        if ((entries[i].key.load(std::memory_order_relaxed) ^ data) == hash && data >> 56) {
+            if (depth < (int8_t)(data >> 48) && (int)(data >> 58) == this->_age)
+                return ;
+            if (move == -1)
+                move = (int16_t)(data >> 32);
+            replaced = &entries[i];
+            break;
+        }
+        if (!(data >> 56)) {
+            replaced = &entries[i];
+            break;
+        }
+        value = (int8_t)(data >> 48) - 2 * ((this->_age - (int)(data >> 58) + TT_AGES) % TT_AGES);
+        if (i == 0 || value < lowest) {
+            replaced = &entries[i];
+            lowest = value;
+        }
+    }
+    data = pack(score, move, depth, (this->_age << 2) | (flag & 0x3));
+    replaced->key.store(hash ^ data, std::memory_order_relaxed);
+    replaced->data.store(data, std::memory_order_relaxed);
+}
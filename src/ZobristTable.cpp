@@ -0,0 +1,32 @@
+#include <random>
+#include <cmath>
+#include "ZobristTable.hpp"
+
+/* initialization of Zobrist Hashing */
+static const std::array<std::array<uint64_t, STATES>, CELLS>    _init_zobrist_table_x64(void) {
+    std::array<std::array<uint64_t, STATES>, CELLS> table;
+    /* set up random generator 64-bit */
+    std::random_device  rd;
+    std::mt19937_64     e2(rd());
+    std::uniform_int_distribution<unsigned long long>   dist(std::llround(std::pow(2, 61)), std::llround(std::pow(2, 62)));
+
+    for (int n = 0; n < CELLS; n++)
+        for (int s = 0; s < STATES; s++)
+            table[n][s] = dist(e2);
+    return (table);
+}
+
+static const std::array<std::array<uint64_t, PAIRS>, 2>         _init_zobrist_pairs_x64(void) {
+    std::array<std::array<uint64_t, PAIRS>, 2>  pairs;
+    std::random_device  rd;
+    std::mt19937_64     e2(rd());
+    std::uniform_int_distribution<unsigned long long>   dist(std::llround(std::pow(2, 61)), std::llround(std::pow(2, 62)));
+
+    for (int p = 0; p < 2; p++)
+        for (int n = 0; n < PAIRS; n++)
+            pairs[p][n] = dist(e2);
+    return (pairs);
+}
+
+const std::array<std::array<uint64_t, STATES>, CELLS>   ZobristTable::_table = _init_zobrist_table_x64();
+const std::array<std::array<uint64_t, PAIRS>, 2>        ZobristTable::_pairs = _init_zobrist_pairs_x64();
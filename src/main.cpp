@@ -1,8 +1,8 @@
 #include "Game.hpp"
 
 namespace options {
-    t_options      g_optionsp1 = { 10, 1 };
-    t_options      g_optionsp2 = { 10, 1 };
+    t_options      g_optionsp1 = { 10, 1, 1, smp::lazy, MCTS_ARENA_MB, selection::uct, TT_SIZE_MB };
+    t_options      g_optionsp2 = { 10, 1, 1, smp::lazy, MCTS_ARENA_MB, selection::uct, TT_SIZE_MB };
 }
 
 static bool       check_depth(int depth) {
@@ -26,6 +26,49 @@ static void      get_depth(std::vector<int> depths) {
     }
 }
 
+static void      get_threads(std::vector<int> threads) {
+    if (threads.size() >= 1 && threads[0] >= 1)
+        options::g_optionsp1.threads = threads[0];
+    if (threads.size() == 2 && threads[1] >= 1)
+        options::g_optionsp2.threads = threads[1];
+}
+
+static int      check_smp(int mode) {
+    return (mode == 2 ? smp::split : smp::lazy);
+}
+
+static void      get_smp(std::vector<int> modes) {
+    if (modes.size() >= 1)
+        options::g_optionsp1.smp = check_smp(modes[0]);
+    if (modes.size() == 2)
+        options::g_optionsp2.smp = check_smp(modes[1]);
+}
+
+static void      get_mcts_memory(std::vector<int> sizes) {
+    if (sizes.size() >= 1 && sizes[0] >= 1)
+        options::g_optionsp1.mcts_mb = sizes[0];
+    if (sizes.size() == 2 && sizes[1] >= 1)
+        options::g_optionsp2.mcts_mb = sizes[1];
+}
+
+static int      check_mcts_policy(int policy) {
+    return (policy == 2 ? selection::puct : selection::uct);
+}
+
+static void      get_mcts_policy(std::vector<int> policies) {
+    if (policies.size() >= 1)
+        options::g_optionsp1.mcts_policy = check_mcts_policy(policies[0]);
+    if (policies.size() == 2)
+        options::g_optionsp2.mcts_policy = check_mcts_policy(policies[1]);
+}
+
+static void      get_tt_memory(std::vector<int> sizes) {
+    if (sizes.size() >= 1 && sizes[0] >= 1)
+        options::g_optionsp1.tt_mb = sizes[0];
+    if (sizes.size() == 2 && sizes[1] >= 1)
+        options::g_optionsp2.tt_mb = sizes[1];
+}
+
 static int      check_algo_type(int algo_type, int player) {
     std::cout << "AI player " << player << ": ";
     switch (algo_type) {
@@ -82,7 +125,12 @@ int             main(int argc, char **argv) {
         desc.add_options()
             ("help,h", "Print help options")
             ("ai,a", boost::program_options::value<std::vector<int> >()->multitoken(), "Choose AI algorithm:\n(1) default,\n(2) MinMax,\n(3) AlphaBeta,\n(4) MTDf\n(5) MCTS")
-            ("depth,d", boost::program_options::value<std::vector<int> >()->multitoken(), "Select the maximum depth");
+            ("depth,d", boost::program_options::value<std::vector<int> >()->multitoken(), "Select the maximum depth")
+            ("threads,t", boost::program_options::value<std::vector<int> >()->multitoken(), "Select the number of threads of the default AI (Lazy SMP) and of MCTS")
+            ("smp,s", boost::program_options::value<std::vector<int> >()->multitoken(), "Choose the parallel search of the default AI:\n(1) Lazy SMP,\n(2) Young Brothers Wait")
+            ("mcts-memory,m", boost::program_options::value<std::vector<int> >()->multitoken(), "Select the memory cap of the MCTS tree in MB")
+            ("mcts-policy,p", boost::program_options::value<std::vector<int> >()->multitoken(), "Choose the selection of MCTS:\n(1) UCT,\n(2) PUCT (heuristic priors and progressive widening)")
+            ("tt-memory", boost::program_options::value<std::vector<int> >()->multitoken(), "Select the size of the transposition table of the default AI and of MTDf in MB");
         try {
             boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
             boost::program_options::notify(vm);
@@ -97,6 +145,21 @@ int             main(int argc, char **argv) {
             if (vm.count("depth")) {
                 get_depth(vm["depth"].as<std::vector<int> >());
             }
+            if (vm.count("threads")) {
+                get_threads(vm["threads"].as<std::vector<int> >());
+            }
+            if (vm.count("smp")) {
+                get_smp(vm["smp"].as<std::vector<int> >());
+            }
+            if (vm.count("mcts-memory")) {
+                get_mcts_memory(vm["mcts-memory"].as<std::vector<int> >());
+            }
+            if (vm.count("mcts-policy")) {
+                get_mcts_policy(vm["mcts-policy"].as<std::vector<int> >());
+            }
+            if (vm.count("tt-memory")) {
+                get_tt_memory(vm["tt-memory"].as<std::vector<int> >());
+            }
         }
         catch(boost::program_options::error& e) {
             std::cerr << "Error: " << e.what() << std::endl << desc << std::endl;